@@ -97,6 +97,11 @@ namespace lsp
             static constexpr size_t SC_SPLIT_SOURCE_DFL     = 0;
             static constexpr size_t SC_TYPE_DFL             = 0;
 
+            static constexpr size_t SC_DECIM_MAX            = 8;        // Maximum decimation factor of the sidechain detector
+            static constexpr float  SC_DECIM_REACTIVITY     = 10.0f;    // Minimum reactivity for the decimated sidechain detector [ms]
+
+            static constexpr size_t FEEDBACK_BLOCK          = 16;       // Sub-block size for the block feed-back mode [samples]
+
             static constexpr float  HPF_MIN                 = 10.0f;
             static constexpr float  HPF_MAX                 = 20000.0f;
             static constexpr float  HPF_DFL                 = 10.0f;
@@ -113,6 +118,8 @@ namespace lsp
 
             static constexpr size_t TIME_MESH_SIZE          = 400;
             static constexpr float  TIME_HISTORY_MAX        = 5.0f;
+            static constexpr size_t TIME_ZOOM_RATIO_30S     = 6;        // Points of 5 s history per point of 30 s history
+            static constexpr size_t TIME_ZOOM_RATIO_5M      = 10;       // Points of 30 s history per point of 5 min history
 
             enum mode_t
             {
@@ -122,6 +129,62 @@ namespace lsp
             };
 
             static constexpr size_t CM_DEFAULT              = CM_DOWNWARD;
+
+            enum feedback_mode_t
+            {
+                FBM_EXACT,
+                FBM_BLOCK
+            };
+
+            static constexpr size_t FBM_DEFAULT             = FBM_EXACT;
+
+            enum block_mode_t
+            {
+                BM_AUTO,
+                BM_LOW_LATENCY,
+                BM_BALANCED,
+                BM_THROUGHPUT
+            };
+
+            static constexpr size_t BM_DEFAULT              = BM_AUTO;
+
+            enum history_zoom_t
+            {
+                HZ_5S,
+                HZ_30S,
+                HZ_5M,
+
+                HZ_TOTAL
+            };
+
+            static constexpr size_t HZ_DEFAULT              = HZ_5S;
+
+            enum gain_computer_t
+            {
+                GC_EXACT,
+                GC_TABLE,
+                GC_CONTROL
+            };
+
+            static constexpr size_t GC_DEFAULT              = GC_EXACT;
+
+            enum control_step_t
+            {
+                CS_AUTO,
+                CS_8,
+                CS_16,
+                CS_32,
+                CS_64
+            };
+
+            static constexpr size_t CS_DEFAULT              = CS_AUTO;
+
+            // Stereo compressor keeps 19 chunk-sized buffers: 9.5 KiB for low latency chunks that stay in L1
+            // cache together with delay line blocks, 38 KiB for balanced and 76 KiB for throughput chunks
+            // that stay in L2 cache. Longer chunks leave L2 cache and do not process faster.
+            static constexpr size_t BLOCK_LOW_LATENCY       = 0x80;     // Processing chunk for small host blocks [samples]
+            static constexpr size_t BLOCK_BALANCED          = 0x200;    // Processing chunk for regular host blocks [samples]
+            static constexpr size_t BLOCK_THROUGHPUT        = 0x400;    // Processing chunk for offline rendering [samples]
         };
 
         extern const meta::plugin_t compressor_mono;
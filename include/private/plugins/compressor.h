@@ -27,11 +27,15 @@
 #include <lsp-plug.in/dsp-units/ctl/Bypass.h>
 #include <lsp-plug.in/dsp-units/dynamics/Compressor.h>
 #include <lsp-plug.in/dsp-units/filters/Equalizer.h>
-#include <lsp-plug.in/dsp-units/util/Delay.h>
 #include <lsp-plug.in/dsp-units/util/MeterGraph.h>
 #include <lsp-plug.in/dsp-units/util/Sidechain.h>
 
 #include <private/meta/compressor.h>
+#include <private/plugins/compressor_decimator.h>
+#include <private/plugins/compressor_delay.h>
+#include <private/plugins/compressor_gain.h>
+#include <private/plugins/compressor_history.h>
+#include <private/plugins/compressor_snapshot.h>
 
 namespace lsp
 {
@@ -83,6 +87,24 @@ namespace lsp
                     M_TOTAL
                 };
 
+                enum delay_lane_t
+                {
+                    DL_IN,                                      // Input signal
+                    DL_GAIN,                                    // Gain reduction
+                    DL_DRY,                                     // Dry signal
+
+                    DL_TOTAL
+                };
+
+                enum decim_stream_t
+                {
+                    DS_SC,                                      // Sidechain signal
+                    DS_ENV,                                     // Envelope
+                    DS_GAIN,                                    // Gain reduction
+
+                    DS_TOTAL
+                };
+
                 enum sync_t
                 {
                     S_CURVE     = 1 << 0,
@@ -90,8 +112,64 @@ namespace lsp
                     S_ALL       = S_CURVE
                 };
 
+                enum update_t
+                {
+                    U_SC        = 1 << 0,               // Sidechain settings
+                    U_SC_EQ     = 1 << 1,               // Sidechain equalizer settings
+                    U_LOOKAHEAD = 1 << 2,               // Lookahead delay
+                    U_COMP      = 1 << 3,               // Compressor settings
+                    U_GAIN      = 1 << 4,               // Dry/wet gains
+
+                    U_ALL       = U_SC | U_SC_EQ | U_LOOKAHEAD | U_COMP | U_GAIN
+                };
+
+                enum ch_param_t
+                {
+                    CP_SC_TYPE,
+                    CP_SC_MODE,
+                    CP_SC_REACTIVITY,
+                    CP_SC_PREAMP,
+                    CP_SC_HPF_MODE,
+                    CP_SC_HPF_FREQ,
+                    CP_SC_LPF_MODE,
+                    CP_SC_LPF_FREQ,
+                    CP_SC_LOOKAHEAD,
+                    CP_MODE,
+                    CP_ATTACK_LVL,
+                    CP_RELEASE_LVL,
+                    CP_ATTACK_TIME,
+                    CP_RELEASE_TIME,
+                    CP_HOLD_TIME,
+                    CP_RATIO,
+                    CP_KNEE,
+                    CP_BTHRESH,
+                    CP_BOOST,
+                    CP_MAKEUP,
+                    CP_DRY_GAIN,
+                    CP_WET_GAIN,
+                    CP_DRYWET,
+
+                    CP_TOTAL
+                };
+
+                enum premix_route_t
+                {
+                    PR_SC_TO_IN     = 1 << 0,                   // Sidechain -> Input
+                    PR_LINK_TO_IN   = 1 << 1,                   // Link -> Input
+                    PR_IN_TO_SC     = 1 << 2,                   // Input -> Sidechain
+                    PR_LINK_TO_SC   = 1 << 3,                   // Link -> Sidechain
+                    PR_IN_TO_LINK   = 1 << 4,                   // Input -> Link
+                    PR_SC_TO_LINK   = 1 << 5,                   // Sidechain -> Link
+
+                    PR_TO_IN        = PR_SC_TO_IN | PR_LINK_TO_IN,
+                    PR_TO_SC        = PR_IN_TO_SC | PR_LINK_TO_SC,
+                    PR_TO_LINK      = PR_IN_TO_LINK | PR_SC_TO_LINK,
+                    PR_FROM_LINK    = PR_LINK_TO_IN | PR_LINK_TO_SC
+                };
+
                 typedef struct premix_t
                 {
+                    uint32_t            nRoutes;                // Active routes
                     float               fInToSc;                // Input -> Sidechain mix
                     float               fInToLink;              // Input -> Link mix
                     float               fLinkToIn;              // Link -> Input mix
@@ -116,32 +194,9 @@ namespace lsp
                     plug::IPort        *pScToLink;              // Sidechain -> Link mix
                 } premix_t;
 
-                typedef struct channel_t
+                typedef struct channel_ports_t
                 {
-                    dspu::Bypass        sBypass;                // Bypass
-                    dspu::Sidechain     sSC;                    // Sidechain module
-                    dspu::Equalizer     sSCEq;                  // Sidechain equalizer
-                    dspu::Compressor    sComp;                  // Compression module
-                    dspu::Delay         sLaDelay;               // Lookahead delay
-                    dspu::Delay         sInDelay;               // Input compensation delay
-                    dspu::Delay         sOutDelay;              // Output compensation delay
-                    dspu::Delay         sDryDelay;              // Dry delay
-                    dspu::MeterGraph    sGraph[G_TOTAL];        // Input meter graph
-
-                    float              *vIn;                    // Input data
-                    float              *vOut;                   // Output data
-                    float              *vSc;                    // Sidechain data
-                    float              *vEnv;                   // Envelope data
-                    float              *vGain;                  // Gain reduction data
-                    bool                bScListen;              // Listen sidechain
-                    uint32_t            nSync;                  // Synchronization flags
-                    uint32_t            nScType;                // Sidechain type
-                    float               fMakeup;                // Makeup gain
-                    float               fFeedback;              // Feedback
-                    float               fDryGain;               // Dry gain
-                    float               fWetGain;               // Wet gain
-                    float               fDotIn;                 // Dot input gain
-                    float               fDotOut;                // Dot output gain
+                    float               vParams[CP_TOTAL];      // Last applied parameter values
 
                     plug::IPort        *pIn;                    // Input port
                     plug::IPort        *pOut;                   // Output port
@@ -180,12 +235,113 @@ namespace lsp
                     plug::IPort        *pDryWet;                // Dry/Wet balance
                     plug::IPort        *pCurve;                 // Curve graph
                     plug::IPort        *pReleaseOut;            // Output release level
+                    plug::IPort        *pCtlError;              // Output control rate error
+                } channel_ports_t;
+
+                typedef struct curve_key_t
+                {
+                    uint32_t            nMode;                  // Compression mode
+                    float               fThreshold;             // Attack threshold
+                    float               fBThresh;               // Boost threshold
+                    float               fBoost;                 // Boost signal amount
+                    float               fRatio;                 // Ratio
+                    float               fKnee;                  // Knee
+                    float               fMakeup;                // Makeup gain
+                } curve_key_t;
+
+                typedef struct channel_aux_t
+                {
+                    SidechainDecimator  sDecim;                 // Decimator of the sidechain for the decimated detector
+                    dspu::Sidechain     sDSC;                   // Decimated sidechain module
+                    dspu::Equalizer     vDSCEq[SidechainDecimator::CHANNELS_MAX];  // Sidechain equalizers applied before decimation
+                    GainComputer        sDGain;                 // Decimated gain computer
+                    dspu::Equalizer     sSCEq;                  // Sidechain equalizer, accessed by the sidechain module
+                    dspu::Bypass        sBypass;                // Bypass
+                    dspu::MeterGraph    sGraph[G_TOTAL];        // Input meter graph
+                    HistoryPyramid      sHistory[G_TOTAL];      // Zoomed out history of meter graphs
+                    uint32_t            nSync;                  // Synchronization flags
+                    uint32_t            nUpdate;                // Forced reconfiguration flags
+                    size_t              nScSource;              // Last applied sidechain source
+                    float               fMakeup;                // Makeup gain
+                    float               fDotIn;                 // Dot input gain
+                    float               fDotOut;                // Dot output gain
+                    curve_key_t         sCurveKey;              // Parameters the curve is computed for
+                    float              *vScBuf;                 // Storage of sidechain data, vSc may refer to another channel
+                    float              *vEnvBuf;                // Storage of envelope data, vEnv may refer to another channel
+                    float              *vGainBuf;               // Storage of gain reduction data, vGain may refer to another channel
+                    float              *vGainCurve;             // Storage of the compression curve
+                    const float        *pGainCurve;             // Compression curve with applied makeup, may be shared with another channel
+                } channel_aux_t;
+
+                typedef struct channel_t
+                {
+                    // Hot data: accessed for each sample or each processing chunk, hot data of all channels
+                    // is stored contiguously, the rest of the channel state is stored in the separate array
+                    float              *vIn __lsp_aligned64;    // Input data
+                    float              *vOut;                   // Output data
+                    float              *vSc;                    // Sidechain data
+                    float              *vEnv;                   // Envelope data
+                    float              *vGain;                  // Gain reduction data
+                    float              *vDry;                   // Dry signal crossfaded between latencies
+                    float              *vFbHistory;             // Output history for the block feed-back mode
+                    const float        *vDelayIn;               // Latency-compensated input of the current block
+                    const float        *vDelayDry;              // Latency-compensated dry signal of the current block
+                    float               fFeedback;              // Feedback
+                    float               fDryGain;               // Dry gain
+                    float               fWetGain;               // Wet gain
+                    float               fEnvLevel;              // Last envelope value
+                    float               fGainLevel;             // Last gain value
+                    float               fIdleLevel;             // Envelope level below which the idle mode is allowed
+                    uint32_t            nScType;                // Sidechain type
+                    bool                bScListen;              // Listen sidechain
+                    size_t              nLookahead;             // Lookahead delay
+                    size_t              nOldLookahead;          // Lookahead delay before the latency change
+                    size_t              nNewLookahead;          // Lookahead delay to apply with the next latency change
+                    size_t              nScPad;                 // Part of the lookahead reserved for the decimated detector and not used by it
+
+                    dspu::Sidechain     sSC;                    // Sidechain module
+                    dspu::Compressor    sComp;                  // Compression module
+                    GainComputer        sGainComp;              // Lookup table gain computer
+                    MultiTapDelay       sDelay;                 // Lookahead and latency compensation delay
+
+                    channel_aux_t      *pAux;                   // Metering, settings and rarely used processing state
+                    channel_ports_t    *pPorts;                 // Port bindings
                 } channel_t;
 
+                typedef struct display_t
+                {
+                    uint32_t            nVersion;               // Snapshot version
+                    uint32_t            nCurveVersion;          // Version of the curves stored in the snapshot
+                    size_t              nCurves;                // Number of curves
+                    size_t              nDots;                  // Number of curve dots, zero if dots are hidden
+                    bool                bBypass;                // Bypass is on
+                    bool                bActive;                // Plugin is active
+                    float               vDotIn[2];              // Dot input levels
+                    float               vDotOut[2];             // Dot output levels
+                    float               vCurve[2][meta::compressor_metadata::CURVE_MESH_SIZE];  // Curves with applied makeup
+                } display_t;
+
+                typedef struct display_cache_t
+                {
+                    size_t              nWidth;                 // Width of the canvas
+                    size_t              nHeight;                // Height of the canvas
+                    uint32_t            nCurveVersion;          // Version of the curves stored as polylines, zero if none
+                    size_t              nLines;                 // Number of grid lines
+                    float               fDX;                    // Horizontal scale of the graph
+                    float               fDY;                    // Vertical scale of the graph
+                    float               vGridX[8];              // Horizontal coordinates of the grid lines
+                    float               vGridY[8];              // Vertical coordinates of the grid lines
+                    float               vDiag[4];               // Coordinates of the 1:1 line
+                    float               vAxis[2];               // Coordinates of the axis
+                } display_cache_t;
+
+                typedef void (compressor::*process_func_t)(size_t samples);
+
             protected:
                 size_t          nMode;          // Compressor mode
                 bool            bSidechain;     // External side chain
                 channel_t      *vChannels;      // Compressor channels
+                channel_ports_t*vPorts;         // Port bindings of channels, accessed out of the processing loop
                 float          *vCurve;         // Compressor curve
                 float          *vTime;          // Time points buffer
                 float          *vEmptyBuffer;   // Empty buffer
@@ -193,17 +349,53 @@ namespace lsp
                 bool            bClear;         // Clear button
                 bool            bMSListen;      // Mid/Side listen
                 bool            bStereoSplit;   // Stereo split
+                bool            bFbBlock;       // Block feed-back mode
+                bool            bScDecim;       // Allow decimated sidechain detector
                 float           fInGain;        // Input gain
+                size_t          nLatency;       // Latency
+                size_t          nBlockMode;     // Processing block size mode
+                size_t          nGainComp;      // Gain computer mode
+                size_t          nCtlStep;       // Control step of the gain computer, 0 for automatic
+                size_t          nHostBlock;     // Maximum size of the block passed by the host
+                size_t          nChunkSize;     // Size of the processing chunk
+                size_t          nOldLatency;    // Latency before the change
+                size_t          nFade;          // Number of samples left to crossfade after latency change
+                bool            bDelaySync;     // Delays have changed during the crossfade and wait for it to complete
+                size_t          nFadeLength;    // Length of the latency crossfade
                 bool            bUISync;
                 core::IDBuffer *pIDisplay;      // Inline display buffer
+                process_func_t  pProcess;       // Audio processing routine specialized for current settings
+                bool            bMetering;      // Graph metering is enabled, UI is active
+                uint32_t        nCurveVersion;  // Version of the compressor curves
+                size_t          nDisplayPeriod; // Minimum number of samples between inline display redraw requests
+                size_t          nDisplayDelay;  // Number of samples left before the next redraw request is allowed
+                size_t          nHistoryPeriod; // Number of samples per point of the history graphs
+                size_t          nHistoryPhase;  // Number of samples processed since the last point of the history graphs
+                size_t          nHistoryPoints; // Number of history points appended since the last mesh transfer
+                size_t          nHistoryZoom;   // Zoom level of history graphs
+                display_cache_t sIDCache;       // Inline display geometry, accessed by the display thread only
+                bool            bIdle;          // Idle mode: input is silent and the compressor is at rest
+                size_t          nIdleSamples;   // Number of silent samples processed, saturated at nIdleLimit
+                size_t          nIdleLimit;     // Number of silent samples required to enter idle mode
+                float           fOutGain;       // Output gain
+                uint32_t        nUpdate;        // Subsystems reconfigured by the last update_settings() call
+                size_t          nReconfigs;     // Number of reconfigurations made by the last update_settings() call
+                wsize_t         nReconfigTotal; // Total number of reconfigurations
 
                 premix_t        sPremix;        // Pre-mix settings
+                SnapshotBuffer<display_t>   sDisplay;   // State of the inline display passed from the audio thread
 
                 plug::IPort    *pBypass;        // Bypass port
                 plug::IPort    *pInGain;        // Input gain
                 plug::IPort    *pOutGain;       // Output gain
                 plug::IPort    *pPause;         // Pause gain
                 plug::IPort    *pClear;         // Cleanup gain
+                plug::IPort    *pFbMode;        // Feed-back processing mode
+                plug::IPort    *pBlockMode;     // Processing block size mode
+                plug::IPort    *pHistoryZoom;   // Zoom level of history graphs
+                plug::IPort    *pGainComp;      // Gain computer
+                plug::IPort    *pCtlStep;       // Control step of the gain computer
+                plug::IPort    *pScDecim;       // Decimated sidechain detector
                 plug::IPort    *pMSListen;      // Mid/Side listen
                 plug::IPort    *pStereoSplit;   // Stereo split mode
                 plug::IPort    *pScSpSource;    // Sidechain source for stereo split mode
@@ -212,17 +404,50 @@ namespace lsp
 
             protected:
                 float           process_feedback(channel_t *c, size_t i, size_t channels);
+                void            process_feedback_block(size_t mask, size_t channels, bool linked, size_t samples);
+                void            apply_linked_gain(size_t offset, size_t samples);
+                void            link_channels(bool linked);
+                void            configure_compressor(channel_t *c);
+                void            reset_detector(channel_t *c);
+                void            update_latency();
                 void            process_non_feedback(channel_t *c, float **in, size_t samples);
+                void            process_decimated(channel_t *c, float **in, size_t samples);
+                void            process_non_feedback_x2(float **in_a, float **in_b, size_t samples);
+                inline void     compute_gain(channel_t *c, float *gain, float *env, const float *sc, size_t samples);
                 void            do_destroy();
                 void            update_premix();
+                template <bool SC>
                 void            premix_channel(uint32_t channel, float * & in, float * & out, float * & sc, float * & link, size_t count);
+                void            convert_to_ms(float **in, size_t count);
+                template <size_t MODE>
+                void            output_stage(float **in_buf, float **out_buf, size_t samples);
+                template <size_t MODE, bool LINKED, bool SC, size_t FEEDBACK>
+                void            process_audio(size_t samples);
+                process_func_t  select_process_func(size_t feedback) const;
+                bool            check_idle(size_t samples);
+                uint32_t        fetch_params(channel_t *c);
+                void            compensate_latency(float **dry, size_t samples);
+                void            update_chunk_size();
+                void            publish_display(size_t samples);
+                void            update_history(size_t points);
+                void            update_curves();
+                void            read_history(channel_t *c, size_t graph, float *x, float *y);
+                void            process_bypass(size_t samples);
+                void            process_idle(size_t samples);
                 uint32_t        decode_sidechain_type(uint32_t sc) const;
+                size_t          decimation_factor(const channel_t *c) const;
                 inline float   *select_buffer(const channel_t & c, float *in, float *sc, float *shm);
+                // Graph metering state, define LSP_PLUGINS_COMPRESSOR_HEADLESS to compile graphs out
+                inline bool     metering() const;
 
             protected:
                 static dspu::compressor_mode_t      decode_mode(int mode);
                 static dspu::sidechain_source_t     decode_sidechain_source(int source, bool split, size_t channel);
                 static inline bool                  use_sidechain(const channel_t & c);
+                static void                         update_feedback_history(channel_t *c, const float *out, size_t samples);
+                static inline float                 history_default(size_t graph);
+                static void                         make_curve_key(curve_key_t *key, const channel_ports_t *cp);
+                static inline bool                  same_curve(const curve_key_t & a, const curve_key_t & b);
 
             public:
                 explicit compressor(const meta::plugin_t *metadata, bool sc, size_t mode);
@@ -235,6 +460,7 @@ namespace lsp
                 virtual void    update_settings() override;
                 virtual void    update_sample_rate(long sr) override;
                 virtual void    ui_activated() override;
+                virtual void    ui_deactivated() override;
 
                 virtual void    process(size_t samples) override;
                 virtual bool    inline_display(plug::ICanvas *cv, size_t width, size_t height) override;
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_COMPRESSOR_BATCH_H_
+#define PRIVATE_PLUGINS_COMPRESSOR_BATCH_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp-units/dynamics/Compressor.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+#include <private/plugins/compressor_gain.h>
+#include <private/plugins/compressor_kernels.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Batch of independent mono compressor channels processed in one call.
+         *
+         * The state and the parameters of channels are stored in structure-of-arrays
+         * layout. Channels are processed in groups of 4, 8 or 16 lanes: the sidechain
+         * of the group is interleaved by short blocks, the envelope followers of all
+         * lanes of the group are updated in lockstep by the envelope kernel, the gain
+         * of each lane is taken from its lookup table and applied with the dry/wet mix
+         * by DSP routines.
+         *
+         * Each lane has own compressor settings taken from dspu::Compressor in the same
+         * way as the lookup table gain computer of the compressor channel, own sidechain
+         * preamp and own dry/wet gains.
+         *
+         * This is a reduced model of the compressor for hosts which run many simple
+         * channels, it is not used by the compressor plugin and does not share the
+         * state with its channels. Compared to the plugin channel it has:
+         *   - peak sidechain only: the absolute value of the sidechain signal, or of the
+         *     input signal if the lane has no sidechain, multiplied by the preamp,
+         *     without RMS/low-pass reactivity and without sidechain sources and modes;
+         *   - no sidechain equalizer, no lookahead and no latency compensation;
+         *   - no feed-back sidechain, no makeup gain, no bypass and no metering;
+         *   - the lookup table gain computer only.
+         */
+        class CompressorBatch
+        {
+            public:
+                static constexpr size_t BLOCK_SIZE      = 64;       // Number of samples interleaved at once
+
+            protected:
+                GainComputer   *vGainComp;      // Lookup tables and time constants of lanes
+                const float   **vTables;        // Lookup tables
+                float          *vEnvelope;      // Envelope
+                float          *vPeak;          // Peak of the envelope reached at the attack
+                float          *vTauAttack;     // Attack time constant
+                float          *vTauRelease;    // Release time constant
+                float          *vThresh;        // Envelope level above which the release time constant is used
+                float          *vPreamp;        // Sidechain preamp
+                float          *vDry;           // Dry gain
+                float          *vWet;           // Wet gain
+                float          *vCounter;       // Hold counter [samples]
+                float          *vHold;          // Hold time [samples]
+                float          *vBuffer;        // Interleaved sidechain and envelope of the group, gain of the lane
+                uint32_t        nLanes;         // Number of lanes
+                uint32_t        nCapacity;      // Number of lanes rounded up to the group width
+                uint32_t        nWidth;         // Number of lanes in group
+                uint8_t        *pData;          // Allocated data
+
+            protected:
+                template <size_t W>
+                void            process_group(size_t first, float * const *out, const float * const *in, const float * const *sc, size_t samples);
+
+            public:
+                explicit CompressorBatch();
+                CompressorBatch(const CompressorBatch &) = delete;
+                CompressorBatch(CompressorBatch &&) = delete;
+                ~CompressorBatch();
+
+                CompressorBatch & operator = (const CompressorBatch &) = delete;
+                CompressorBatch & operator = (CompressorBatch &&) = delete;
+
+                void            construct();
+                void            destroy();
+
+            public:
+                /**
+                 * Initialize the batch
+                 *
+                 * @param lanes number of compressor channels
+                 * @param width number of lanes processed together: 4, 8 or 16
+                 * @return true on success
+                 */
+                bool            init(size_t lanes, size_t width);
+
+                /**
+                 * Get number of lanes
+                 * @return number of lanes
+                 */
+                inline size_t   lanes() const               { return nLanes; }
+
+                /**
+                 * Get number of lanes processed together
+                 * @return number of lanes processed together
+                 */
+                inline size_t   width() const               { return nWidth; }
+
+                /**
+                 * Update compressor settings of the lane, should be called after the
+                 * compressor has updated its settings
+                 *
+                 * @param lane lane index
+                 * @param comp compressor to take settings from
+                 * @param sample_rate sample rate
+                 */
+                void            update(size_t lane, dspu::Compressor *comp, size_t sample_rate);
+
+                /**
+                 * Set gains of the lane
+                 *
+                 * @param lane lane index
+                 * @param preamp sidechain preamp
+                 * @param dry dry gain
+                 * @param wet wet gain
+                 */
+                void            set_gains(size_t lane, float preamp, float dry, float wet);
+
+                /**
+                 * Reset envelope followers of all lanes
+                 */
+                void            clear();
+
+                /**
+                 * Process all lanes
+                 *
+                 * @param out output buffers of lanes, may match input buffers
+                 * @param in input buffers of lanes
+                 * @param sc sidechain buffers of lanes, may be NULL, NULL buffer means the input is used
+                 * @param samples number of samples to process
+                 */
+                void            process(float * const *out, const float * const *in, const float * const *sc, size_t samples);
+
+                /**
+                 * Dump the state
+                 * @param v state dumper
+                 */
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_COMPRESSOR_BATCH_H_ */
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_COMPRESSOR_DECIMATOR_H_
+#define PRIVATE_PLUGINS_COMPRESSOR_DECIMATOR_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp-units/filters/Equalizer.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Decimator of the sidechain signal and interpolator of the detector output.
+         *
+         * The input channels are optionally filtered at the original sample rate by the
+         * pre-equalizers, band-limited by the triangular window of 2*N-1 samples and
+         * decimated N times. The window has zeros of the second order at multiples
+         * of the decimated sample rate, so the components aliased to the low frequencies
+         * are strongly suppressed. The detector processes the decimated signal, and its
+         * output streams are linearly interpolated back to the original sample rate with
+         * the delay of one decimated sample. Together with the delay of the window center
+         * the output lags the input by 2*N-1 samples.
+         */
+        class SidechainDecimator
+        {
+            public:
+                static constexpr size_t CHANNELS_MAX    = 2;
+                static constexpr size_t STREAMS_MAX     = 3;
+
+            protected:
+                typedef struct input_t
+                {
+                    float          *vStage;         // History of the input followed by the current block
+                    float          *vData;          // Decimated input
+                    dspu::Equalizer*pPreEq;         // Pre-equalizer applied at the original sample rate
+                } input_t;
+
+                typedef struct stream_t
+                {
+                    float          *vData;          // Decimated detector output
+                    float           fValue;         // Interpolated value
+                    float           fDelta;         // Increment of the value per sample
+                    bool            bInit;          // Value has been initialized by the first decimated sample
+                } stream_t;
+
+            protected:
+                input_t         vInputs[CHANNELS_MAX];
+                stream_t        vStreams[STREAMS_MAX];
+                float          *vWindow;        // Band-limiting window
+                uint32_t        nChannels;      // Number of input channels
+                uint32_t        nStreams;       // Number of output streams
+                uint32_t        nMaxFactor;     // Maximum decimation factor
+                uint32_t        nMaxSamples;    // Maximum number of samples per block
+                uint32_t        nFactor;        // Decimation factor
+                uint32_t        nPhase;         // Number of samples passed since the last decimated sample
+                uint32_t        nFirst;         // Offset of the first decimated sample in the last block
+                uint32_t        nPoints;        // Number of decimated samples in the last block
+                uint8_t        *pData;          // Allocated data
+
+            public:
+                explicit SidechainDecimator();
+                SidechainDecimator(const SidechainDecimator &) = delete;
+                SidechainDecimator(SidechainDecimator &&) = delete;
+                ~SidechainDecimator();
+
+                SidechainDecimator & operator = (const SidechainDecimator &) = delete;
+                SidechainDecimator & operator = (SidechainDecimator &&) = delete;
+
+                void            construct();
+                void            destroy();
+
+            public:
+                /**
+                 * Initialize decimator
+                 *
+                 * @param channels number of input channels
+                 * @param streams number of output streams
+                 * @param max_factor maximum decimation factor
+                 * @param max_samples maximum number of samples processed at once
+                 * @return true on success
+                 */
+                bool            init(size_t channels, size_t streams, size_t max_factor, size_t max_samples);
+
+                /**
+                 * Set decimation factor, the state is reset when the factor changes
+                 * @param factor decimation factor, 1 disables decimation
+                 */
+                void            set_factor(size_t factor);
+
+                /**
+                 * Get decimation factor
+                 * @return decimation factor
+                 */
+                inline size_t   factor() const              { return nFactor; }
+
+                /**
+                 * Get the delay of the interpolated output streams relative to the input
+                 * @return delay in samples, zero if decimation is disabled
+                 */
+                inline size_t   latency() const             { return (nFactor > 1) ? nFactor * 2 - 1 : 0; }
+
+                /**
+                 * Set pre-equalizer of the input channel. The pre-equalizer processes the input
+                 * at the original sample rate before it is decimated, and is not reset by the
+                 * decimator.
+                 *
+                 * @param index index of the channel
+                 * @param eq pre-equalizer, NULL to disable
+                 */
+                inline void     set_pre_equalizer(size_t index, dspu::Equalizer *eq)
+                                                            { vInputs[index].pPreEq = eq; }
+
+                /**
+                 * Reset the state
+                 */
+                void            clear();
+
+                /**
+                 * Decimate the block of input channels
+                 *
+                 * @param in input channels, NULL channels are treated as silence
+                 * @param samples number of samples to process
+                 * @return number of decimated samples written to the decimated input buffers
+                 */
+                size_t          decimate(const float * const *in, size_t samples);
+
+                /**
+                 * Get the buffer with decimated input channel
+                 * @param index index of the channel
+                 * @return decimated input channel
+                 */
+                inline float   *input(size_t index)         { return vInputs[index].vData; }
+
+                /**
+                 * Get the buffer to store the decimated output stream of the detector
+                 * @param index index of the stream
+                 * @return buffer to store the decimated output stream
+                 */
+                inline float   *stream(size_t index)        { return vStreams[index].vData; }
+
+                /**
+                 * Interpolate the decimated output stream for the last decimated block
+                 *
+                 * @param dst destination buffer to store the interpolated stream
+                 * @param index index of the stream
+                 * @param samples number of samples passed to the last decimate() call
+                 */
+                void            interpolate(float *dst, size_t index, size_t samples);
+
+                /**
+                 * Dump the state
+                 * @param v state dumper
+                 */
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_COMPRESSOR_DECIMATOR_H_ */
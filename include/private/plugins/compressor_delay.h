@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_COMPRESSOR_DELAY_H_
+#define PRIVATE_PLUGINS_COMPRESSOR_DELAY_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Multi-tap delay line. Stores several signals (lanes) in ring buffers
+         * that share the same write position. The beginning of each ring buffer
+         * is mirrored past its end, so any tap of the last appended block is
+         * a contiguous range of memory and can be read without copying.
+         *
+         * The processing of each block is:
+         *   1. append() the block to each lane;
+         *   2. read taps of the block with tap();
+         *   3. advance() the write position.
+         * Pointers returned by tap() remain valid until the next call of append().
+         */
+        class MultiTapDelay
+        {
+            protected:
+                float          *vData;          // Data of all lanes
+                size_t          nLanes;         // Number of lanes
+                size_t          nSize;          // Size of the ring buffer
+                size_t          nStride;        // Distance between lanes
+                size_t          nBlock;         // Maximum block size
+                size_t          nMaxDelay;      // Maximum delay
+                size_t          nHead;          // Write position
+                uint8_t        *pData;          // Allocated data
+
+            public:
+                explicit MultiTapDelay();
+                MultiTapDelay(const MultiTapDelay &) = delete;
+                MultiTapDelay(MultiTapDelay &&) = delete;
+                ~MultiTapDelay();
+
+                MultiTapDelay & operator = (const MultiTapDelay &) = delete;
+                MultiTapDelay & operator = (MultiTapDelay &&) = delete;
+
+                void            construct();
+                void            destroy();
+
+            public:
+                /**
+                 * Initialize delay line. The memory is not touched until the first use,
+                 * so the delay line should be cleared before it is fed with data
+                 *
+                 * @param lanes number of lanes
+                 * @param max_delay maximum delay in samples
+                 * @param block maximum number of samples appended at once
+                 * @return true on success
+                 */
+                bool            init(size_t lanes, size_t max_delay, size_t block);
+
+                /**
+                 * Fill all lanes with silence
+                 */
+                void            clear();
+
+                /**
+                 * Append block of samples to the lane
+                 *
+                 * @param lane lane number
+                 * @param src source samples
+                 * @param count number of samples, should not exceed the block size
+                 */
+                void            append(size_t lane, const float *src, size_t count);
+
+                /**
+                 * Get the last appended block of samples delayed by the specified amount
+                 *
+                 * @param lane lane number
+                 * @param delay delay in samples, should not exceed the maximum delay
+                 * @return pointer to the delayed block of samples
+                 */
+                const float    *tap(size_t lane, size_t delay) const;
+
+                /**
+                 * Move the write position after all lanes have been appended
+                 *
+                 * @param count number of samples appended to each lane
+                 */
+                void            advance(size_t count);
+
+                /**
+                 * Get the maximum possible delay
+                 * @return maximum possible delay
+                 */
+                inline size_t   max_delay() const   { return nMaxDelay; }
+
+                /**
+                 * Dump the state
+                 * @param v state dumper
+                 */
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_COMPRESSOR_DELAY_H_ */
@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_COMPRESSOR_GAIN_H_
+#define PRIVATE_PLUGINS_COMPRESSOR_GAIN_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp-units/dynamics/Compressor.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        static constexpr size_t     GAIN_SEG_BITS       = 5;                        // Number of segments per octave, log2
+        static constexpr size_t     GAIN_FRAC_BITS      = 23 - GAIN_SEG_BITS;       // Bits of the mantissa addressing the position in segment
+        static constexpr int        GAIN_EXP_MIN        = -24;                      // Minimum envelope: 2^-24, about -144 dB
+        static constexpr int        GAIN_EXP_MAX        = 16;                       // Maximum envelope: 2^16, about +96 dB
+        static constexpr size_t     GAIN_SEGMENTS       = size_t(GAIN_EXP_MAX - GAIN_EXP_MIN) << GAIN_SEG_BITS;
+        static constexpr size_t     GAIN_POINTS         = GAIN_SEGMENTS + 1;
+        static constexpr uint32_t   GAIN_BITS_MIN       = uint32_t(127 + GAIN_EXP_MIN) << 23;
+        static constexpr uint32_t   GAIN_BITS_MAX       = uint32_t(127 + GAIN_EXP_MAX) << 23;
+        static constexpr float      GAIN_FRAC_NORM      = 1.0f / float(1 << GAIN_FRAC_BITS);
+
+        typedef union gain_cast_t
+        {
+            float       f;
+            uint32_t    u;
+        } gain_cast_t;
+
+        /**
+         * Gain computer driven by the lookup table of the static compression curve.
+         * The envelope follower mirrors the one of dspu::Compressor, the gain reduction
+         * is interpolated from the table built once per change of the compressor
+         * settings instead of evaluating the curve in the logarithmic domain for
+         * each sample.
+         *
+         * The scalar envelope follower of this class is the reference one: it is tested
+         * against dspu::Compressor, and the lane kernels and the batch processing are
+         * tested against it.
+         *
+         * Each octave of the envelope is split into equal segments, so the segment
+         * and the position inside the segment are taken directly from the exponent
+         * and mantissa bits of the envelope value without calling logf().
+         *
+         * In the control rate mode the envelope and gain are computed once per step
+         * from the peak of the sidechain signal over the step, and both are linearly
+         * interpolated between control points. The interpolation follows the control
+         * points with the delay of one step.
+         */
+        class GainComputer
+        {
+            protected:
+                float          *vTable;         // Gain reduction at the points of the table followed by the padding point
+                float           fEnvelope;      // Current envelope
+                float           fPeak;          // Peak of the envelope reached at the attack
+                float           fTauAttack;     // Attack time constant
+                float           fTauRelease;    // Release time constant
+                float           fReleaseThresh; // Envelope level above which the release time constant is used
+                uint32_t        nHold;          // Hold time [samples]
+                uint32_t        nHoldCounter;   // Hold counter
+                float           fMaxError;      // Maximum relative error of the table against the exact curve
+                float           fAttack;        // Attack time [samples]
+
+                uint32_t        nStepSetup;     // Requested control step, 0 for automatic
+                uint32_t        nStep;          // Number of samples between control points
+                uint32_t        nPhase;         // Number of samples passed since the last control point
+                uint32_t        nCtlHold;       // Hold time [control points]
+                float           fCtlTauAttack;  // Attack time constant per control point
+                float           fCtlTauRelease; // Release time constant per control point
+                float           fCtlInput;      // Peak of the sidechain signal since the last control point
+                float           fCtlEnv;        // Interpolated envelope
+                float           fCtlGain;       // Interpolated gain reduction
+                float           fEnvDelta;      // Envelope increment per sample
+                float           fGainDelta;     // Gain reduction increment per sample
+                float           fCtlError;      // Maximum deviation of the interpolated envelope relative to the level change
+                uint8_t        *pData;          // Allocated data
+
+            protected:
+                inline float    envelope(float s, float tau_attack, float tau_release, uint32_t hold);
+                void            update_control();
+
+            public:
+                explicit GainComputer();
+                GainComputer(const GainComputer &) = delete;
+                GainComputer(GainComputer &&) = delete;
+                ~GainComputer();
+
+                GainComputer & operator = (const GainComputer &) = delete;
+                GainComputer & operator = (GainComputer &&) = delete;
+
+                void            construct();
+                void            destroy();
+
+            public:
+                /**
+                 * Allocate the lookup table
+                 * @return true on success
+                 */
+                bool            init();
+
+                /**
+                 * Rebuild the lookup table and time constants from the compressor,
+                 * should be called after the compressor has updated its settings
+                 *
+                 * @param comp compressor to take settings from
+                 * @param sample_rate sample rate
+                 * @param table rebuild the lookup table, the time constants are updated anyway
+                 */
+                void            update(dspu::Compressor *comp, size_t sample_rate, bool table = true);
+
+                /**
+                 * Reset the envelope follower
+                 */
+                void            clear();
+
+                /**
+                 * Reset the envelope follower to the specified envelope level, the
+                 * hold is not active. The gain of the control rate mode is taken from
+                 * the lookup table, so the table should be actual
+                 *
+                 * @param env envelope level
+                 */
+                void            reset(float env);
+
+                /**
+                 * Set the number of samples between control points for the control rate mode,
+                 * does nothing if the step has not changed
+                 *
+                 * @param step number of samples, 0 to derive the step from the attack time
+                 */
+                void            set_step(size_t step);
+
+                /**
+                 * Get the actual number of samples between control points
+                 * @return actual number of samples between control points
+                 */
+                inline size_t   step() const            { return nStep; }
+
+                /**
+                 * Get gain reduction for the envelope value
+                 *
+                 * @param env envelope value
+                 * @return gain reduction
+                 */
+                inline float    reduction(float env) const  { return lookup(vTable, env); }
+
+                /**
+                 * Get gain reduction for the envelope value from the lookup table
+                 *
+                 * @param table lookup table
+                 * @param env envelope value
+                 * @return gain reduction
+                 */
+                static inline float lookup(const float *table, float env);
+
+                /**
+                 * Get the lookup table
+                 * @return lookup table
+                 */
+                inline const float *table() const       { return vTable; }
+
+                /**
+                 * Get attack time constant of the envelope follower
+                 * @return attack time constant
+                 */
+                inline float    tau_attack() const      { return fTauAttack; }
+
+                /**
+                 * Get release time constant of the envelope follower
+                 * @return release time constant
+                 */
+                inline float    tau_release() const     { return fTauRelease; }
+
+                /**
+                 * Get envelope level above which the release time constant is used
+                 * @return release threshold
+                 */
+                inline float    release_threshold() const { return fReleaseThresh; }
+
+                /**
+                 * Get hold time
+                 * @return hold time [samples]
+                 */
+                inline size_t   hold() const            { return nHold; }
+
+                /**
+                 * Compute envelope and gain reduction
+                 *
+                 * @param out output gain reduction
+                 * @param env output envelope, may be NULL
+                 * @param in sidechain signal
+                 * @param samples number of samples to process
+                 */
+                void            process(float *out, float *env, const float *in, size_t samples);
+
+                /**
+                 * Compute envelope and gain reduction for single sample
+                 *
+                 * @param env pointer to store the envelope value, may be NULL
+                 * @param s sidechain sample
+                 * @return gain reduction
+                 */
+                float           process(float *env, float s);
+
+                /**
+                 * Compute the envelope only, the gain reduction is computed by the caller
+                 *
+                 * @param env output envelope
+                 * @param in sidechain signal
+                 * @param samples number of samples to process
+                 */
+                void            process_envelope(float *env, const float *in, size_t samples);
+
+                /**
+                 * Compute the envelope for single sample
+                 *
+                 * @param s sidechain sample
+                 * @return envelope value
+                 */
+                float           process_envelope(float s);
+
+                /**
+                 * Compute envelope and gain reduction at control rate and interpolate
+                 * them between control points
+                 *
+                 * @param out output gain reduction
+                 * @param env output envelope, may be NULL
+                 * @param in sidechain signal
+                 * @param samples number of samples to process
+                 */
+                void            process_control(float *out, float *env, const float *in, size_t samples);
+
+                /**
+                 * Compute envelope and gain reduction for two independent gain computers
+                 * in lockstep. The envelope followers of both computers are updated by the
+                 * lane kernel in the same branch-free loop iteration, so the recursions of
+                 * two channels are interleaved instead of running one after another. The
+                 * result is the same as of separate process() calls.
+                 *
+                 * @param gc pair of gain computers
+                 * @param out pair of output gain reduction buffers
+                 * @param env pair of output envelope buffers
+                 * @param in pair of sidechain signals
+                 * @param samples number of samples to process
+                 */
+                static void     process_x2(GainComputer * const *gc, float * const *out, float * const *env, const float * const *in, size_t samples);
+
+                /**
+                 * Get the upper bound of the relative error of the lookup table against
+                 * the exact curve within the range of the table
+                 * @return upper bound of the relative error
+                 */
+                inline float    max_error() const       { return fMaxError; }
+
+                /**
+                 * Get the upper bound of the deviation of the envelope computed at control rate
+                 * from the envelope computed for each sample, relative to the level change of
+                 * the sidechain signal. The bound is the change of the envelope over two control
+                 * steps: one for the peak taken over the step and one for the interpolation lag
+                 * @return upper bound of the relative deviation of the envelope
+                 */
+                inline float    control_error() const   { return fCtlError; }
+
+                /**
+                 * Dump the state
+                 * @param v state dumper
+                 */
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+        inline float GainComputer::lookup(const float *table, float env)
+        {
+            gain_cast_t v;
+            v.f             = env;
+
+            // Values outside of the table take the gain of the nearest edge. The table has
+            // the padding point after the last one, so the edges do not need branches.
+            uint32_t u      = (v.f > 0.0f) ? v.u : GAIN_BITS_MIN;
+            u               = (u > GAIN_BITS_MIN) ? u : GAIN_BITS_MIN;
+            u               = (u < GAIN_BITS_MAX) ? u : GAIN_BITS_MAX;
+
+            const uint32_t off  = u - GAIN_BITS_MIN;
+            const float *t      = &table[off >> GAIN_FRAC_BITS];
+            const float k       = float(off & ((1 << GAIN_FRAC_BITS) - 1)) * GAIN_FRAC_NORM;
+
+            return t[0] + (t[1] - t[0]) * k;
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_COMPRESSOR_GAIN_H_ */
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_COMPRESSOR_HISTORY_H_
+#define PRIVATE_PLUGINS_COMPRESSOR_HISTORY_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Min/max decimation pyramid over the points of the meter graph. Each level
+         * keeps the same number of points, and each point of the level covers the
+         * specified number of points of the previous level. Levels are updated
+         * incrementally when the point of the meter graph is appended, so the cost
+         * is O(1) amortized per appended point.
+         */
+        class HistoryPyramid
+        {
+            protected:
+                typedef struct level_t
+                {
+                    float              *vMin;           // Minimums of points
+                    float              *vMax;           // Maximums of points
+                    size_t              nRatio;         // Number of points of the previous level per point
+                    size_t              nCount;         // Number of points accumulated in the current point
+                    size_t              nHead;          // Write position
+                    float               fMin;           // Minimum of the current point
+                    float               fMax;           // Maximum of the current point
+                } level_t;
+
+            protected:
+                level_t        *vLevels;        // Levels
+                size_t          nLevels;        // Number of levels
+                size_t          nPoints;        // Number of points per level
+                bool            bMinimum;       // Output minimums instead of maximums
+                uint8_t        *pData;          // Allocated data
+
+            public:
+                explicit HistoryPyramid();
+                HistoryPyramid(const HistoryPyramid &) = delete;
+                HistoryPyramid(HistoryPyramid &&) = delete;
+                ~HistoryPyramid();
+
+                HistoryPyramid & operator = (const HistoryPyramid &) = delete;
+                HistoryPyramid & operator = (HistoryPyramid &&) = delete;
+
+                void            construct();
+                void            destroy();
+
+            public:
+                /**
+                 * Initialize the pyramid
+                 *
+                 * @param points number of points per level
+                 * @param ratios number of points of the previous level per point of each level
+                 * @param levels number of levels
+                 * @return true on success
+                 */
+                bool            init(size_t points, const size_t *ratios, size_t levels);
+
+                /**
+                 * Fill all levels with the value
+                 *
+                 * @param value value to fill
+                 */
+                void            clear(float value);
+
+                /**
+                 * Select the output of levels
+                 *
+                 * @param minimum output minimums of points instead of maximums
+                 */
+                inline void     set_minimum(bool minimum)   { bMinimum = minimum; }
+
+                /**
+                 * Append points of the meter graph
+                 *
+                 * @param src points of the meter graph, the oldest first
+                 * @param count number of points
+                 */
+                void            push(const float *src, size_t count);
+
+                /**
+                 * Read all points of the level, the oldest first
+                 *
+                 * @param level level number
+                 * @param dst destination buffer to store points
+                 */
+                void            read(size_t level, float *dst) const;
+
+                /**
+                 * Get the number of levels
+                 * @return number of levels
+                 */
+                inline size_t   levels() const      { return nLevels; }
+
+                /**
+                 * Dump the state
+                 * @param v state dumper
+                 */
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_COMPRESSOR_HISTORY_H_ */
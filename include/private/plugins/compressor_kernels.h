@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_COMPRESSOR_KERNELS_H_
+#define PRIVATE_PLUGINS_COMPRESSOR_KERNELS_H_
+
+#include <lsp-plug.in/common/types.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Processing kernels of the compressor plugin which are not covered by the
+         * DSP library: envelope followers of several independent lanes updated in lockstep.
+         */
+        namespace kernels
+        {
+            /**
+             * State of envelope followers of lanes in structure-of-arrays layout
+             */
+            typedef struct envelope_state_t
+            {
+                float          *vEnvelope;      // Envelope
+                float          *vPeak;          // Peak of the envelope reached at the attack
+                float          *vCounter;       // Hold counter [samples]
+                const float    *vTauAttack;     // Attack time constant
+                const float    *vTauRelease;    // Release time constant
+                const float    *vThresh;        // Envelope level above which the release time constant is used
+                const float    *vHold;          // Hold time [samples]
+            } envelope_state_t;
+
+            /**
+             * Lockstep envelope followers: update envelopes of all lanes for each sample
+             * of the interleaved sidechain signal, the same way as GainComputer does
+             *
+             * @param env destination buffer for interleaved envelope
+             * @param sc interleaved sidechain signal
+             * @param st state of envelope followers of lanes
+             * @param lanes number of lanes
+             * @param count number of samples to process
+             */
+            void            envelope(float *env, const float *sc, const envelope_state_t *st, size_t lanes, size_t count);
+
+            /**
+             * Lockstep envelope followers for lanes stored in separate buffers, the same
+             * as envelope() but without interleaving of the sidechain signal
+             *
+             * @param env destination buffers for envelope of each lane, may match sidechain buffers
+             * @param sc sidechain signal of each lane
+             * @param st state of envelope followers of lanes
+             * @param lanes number of lanes
+             * @param count number of samples to process
+             */
+            void            envelope_planar(float * const *env, const float * const *sc, const envelope_state_t *st, size_t lanes, size_t count);
+
+        } /* namespace kernels */
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_COMPRESSOR_KERNELS_H_ */
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_COMPRESSOR_SNAPSHOT_H_
+#define PRIVATE_PLUGINS_COMPRESSOR_SNAPSHOT_H_
+
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/types.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Wait-free triple buffer to pass snapshots of the state from one writer
+         * thread to one reader thread. The writer fills the back slot and publishes
+         * it, the reader takes the most recently published slot. Neither side ever
+         * waits for another one, and the slot owned by one side is never modified
+         * by another one.
+         */
+        template <class T>
+        class SnapshotBuffer
+        {
+            private:
+                enum flags_t
+                {
+                    F_INDEX     = 0x03,                 // Index of the shared slot
+                    F_FRESH     = 0x04                  // The shared slot has not been fetched yet
+                };
+
+            private:
+                T               vSlots[3];              // Slots
+                atomic_t        nShared;                // Shared slot and flags
+                uint32_t        nBack;                  // Slot owned by the writer
+                uint32_t        nLast;                  // Slot published last by the writer
+                uint32_t        nFront;                 // Slot owned by the reader
+
+            public:
+                explicit SnapshotBuffer(): vSlots()
+                {
+                    nShared     = 1;
+                    nBack       = 0;
+                    nLast       = 1;
+                    nFront      = 2;
+                }
+
+                SnapshotBuffer(const SnapshotBuffer &) = delete;
+                SnapshotBuffer(SnapshotBuffer &&) = delete;
+                SnapshotBuffer & operator = (const SnapshotBuffer &) = delete;
+                SnapshotBuffer & operator = (SnapshotBuffer &&) = delete;
+
+            public:
+                /**
+                 * Get the slot to fill, writer side. The slot contains a snapshot
+                 * that has been published before, not necessarily the last one
+                 * @return slot to fill
+                 */
+                inline T       *back()          { return &vSlots[nBack]; }
+
+                /**
+                 * Get the snapshot published last, writer side. Slots are modified
+                 * only by the writer, so the reader may access it at the same time
+                 * @return snapshot published last
+                 */
+                inline const T *last() const    { return &vSlots[nLast]; }
+
+                /**
+                 * Publish the back slot, writer side
+                 */
+                inline void     publish()
+                {
+                    nLast       = nBack;
+                    nBack       = atomic_swap(&nShared, atomic_t(nBack | F_FRESH)) & F_INDEX;
+                }
+
+                /**
+                 * Get the most recent snapshot, reader side. The snapshot remains
+                 * valid until the next call
+                 * @return most recent snapshot
+                 */
+                inline const T *front()
+                {
+                    if (atomic_load(&nShared) & F_FRESH)
+                        nFront      = atomic_swap(&nShared, atomic_t(nFront)) & F_INDEX;
+                    return &vSlots[nFront];
+                }
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_COMPRESSOR_SNAPSHOT_H_ */
@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_TEST_COMPRESSOR_INSTANCE_H_
+#define PRIVATE_TEST_COMPRESSOR_INSTANCE_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/plug-fw/meta/func.h>
+#include <lsp-plug.in/plug-fw/plug.h>
+
+#include <private/plugins/compressor.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace lsp
+{
+    namespace test
+    {
+        /**
+         * Port stub: stores the value or the audio buffer
+         */
+        class TestPort: public plug::IPort
+        {
+            private:
+                float       fValue;
+                float      *pBuffer;
+
+            public:
+                explicit TestPort(const meta::port_t *meta, float *buffer): plug::IPort(meta)
+                {
+                    fValue      = meta->start;
+                    pBuffer     = buffer;
+                }
+
+            public:
+                virtual float value() override
+                {
+                    // Bypass port is inverted by wrappers: 'enabled' = 1 means no bypass
+                    return (pMetadata->role == meta::R_BYPASS) ? 1.0f - fValue : fValue;
+                }
+
+                virtual void set_value(float value) override
+                {
+                    fValue      = value;
+                }
+
+                virtual void *buffer() override
+                {
+                    return pBuffer;
+                }
+        };
+
+        /**
+         * Wrapper stub: no executor, no position, display requests are ignored
+         */
+        class TestWrapper: public plug::IWrapper
+        {
+            public:
+                explicit TestWrapper(plug::Module *plugin): plug::IWrapper(plugin, NULL)
+                {
+                }
+
+            public:
+                virtual void query_display_draw() override
+                {
+                }
+        };
+
+        /**
+         * Compressor plugin instance with bound ports, each audio port has own buffer
+         */
+        typedef struct compressor_instance_t
+        {
+            const meta::plugin_t   *meta;
+            plugins::compressor    *plugin;
+            TestWrapper            *wrapper;
+            plug::IPort           **ports;
+            float                 **buffers;
+            size_t                  nports;
+            size_t                  nchannels;
+        } compressor_instance_t;
+
+        /**
+         * Destroy the instance, can be called for partially created instance
+         * @param inst instance to destroy
+         */
+        inline void destroy_instance(compressor_instance_t *inst)
+        {
+            if (inst->plugin != NULL)
+            {
+                inst->plugin->deactivate();
+                inst->plugin->destroy();
+                delete inst->plugin;
+                inst->plugin    = NULL;
+            }
+            if (inst->wrapper != NULL)
+            {
+                delete inst->wrapper;
+                inst->wrapper   = NULL;
+            }
+            if (inst->ports != NULL)
+            {
+                for (size_t i=0; i<inst->nports; ++i)
+                    delete inst->ports[i];
+                free(inst->ports);
+                inst->ports     = NULL;
+            }
+            if (inst->buffers != NULL)
+            {
+                for (size_t i=0; i<inst->nports; ++i)
+                    if (inst->buffers[i] != NULL)
+                        free(inst->buffers[i]);
+                free(inst->buffers);
+                inst->buffers   = NULL;
+            }
+        }
+
+        /**
+         * Create and activate the instance of compressor
+         *
+         * @param inst instance to initialize
+         * @param metadata plugin metadata
+         * @param sc plugin has sidechain inputs
+         * @param mode compressor mode
+         * @param sample_rate sample rate
+         * @param buf_size size of audio buffers, maximum number of samples per process() call
+         * @return true on success, the partially created instance should be destroyed on error
+         */
+        inline bool create_instance(compressor_instance_t *inst, const meta::plugin_t *metadata, bool sc, size_t mode,
+            size_t sample_rate, size_t buf_size)
+        {
+            memset(inst, 0, sizeof(compressor_instance_t));
+            inst->meta      = metadata;
+            for (const meta::port_t *p = metadata->ports; p->id != NULL; ++p)
+            {
+                ++inst->nports;
+                if (meta::is_audio_port(p))
+                    ++inst->nchannels;
+            }
+
+            inst->ports     = static_cast<plug::IPort **>(calloc(inst->nports, sizeof(plug::IPort *)));
+            inst->buffers   = static_cast<float **>(calloc(inst->nports, sizeof(float *)));
+            if ((inst->ports == NULL) || (inst->buffers == NULL))
+                return false;
+
+            // Create ports
+            size_t idx      = 0;
+            for (const meta::port_t *p = metadata->ports; p->id != NULL; ++p, ++idx)
+            {
+                float *buf          = NULL;
+                if (meta::is_audio_port(p))
+                {
+                    buf                 = static_cast<float *>(calloc(buf_size, sizeof(float)));
+                    if (buf == NULL)
+                        return false;
+                }
+                inst->buffers[idx]  = buf;
+                inst->ports[idx]    = new TestPort(p, buf);
+            }
+
+            // Create the plugin
+            inst->plugin    = new plugins::compressor(metadata, sc, mode);
+            inst->wrapper   = new TestWrapper(inst->plugin);
+            inst->plugin->init(inst->wrapper, inst->ports);
+            inst->plugin->set_sample_rate(sample_rate);
+            inst->plugin->activate();
+
+            return true;
+        }
+
+        /**
+         * Set value of the port. Both the plain identifier and the per-channel identifiers
+         * are matched: 'id', 'id_l', 'id_r', ...
+         *
+         * @param inst instance
+         * @param id port identifier
+         * @param value value to set
+         * @return number of ports matched
+         */
+        inline size_t set_port(compressor_instance_t *inst, const char *id, float value)
+        {
+            const size_t len    = strlen(id);
+            size_t matched      = 0;
+            for (size_t i=0; i<inst->nports; ++i)
+            {
+                const char *pid     = inst->ports[i]->metadata()->id;
+                if (strncmp(pid, id, len) != 0)
+                    continue;
+                if ((pid[len] == '\0') || ((pid[len] == '_') && (pid[len+1] != '\0') && (pid[len+2] == '\0')))
+                {
+                    inst->ports[i]->set_value(value);
+                    ++matched;
+                }
+            }
+
+            return matched;
+        }
+
+        /**
+         * Get audio buffer of the port
+         *
+         * @param inst instance
+         * @param id exact port identifier
+         * @return audio buffer or NULL if there is no such audio port
+         */
+        inline float *port_buffer(compressor_instance_t *inst, const char *id)
+        {
+            for (size_t i=0; i<inst->nports; ++i)
+            {
+                if (!strcmp(inst->ports[i]->metadata()->id, id))
+                    return inst->buffers[i];
+            }
+
+            return NULL;
+        }
+
+        /**
+         * Reset all ports to default values
+         * @param inst instance
+         */
+        inline void reset_ports(compressor_instance_t *inst)
+        {
+            for (size_t i=0; i<inst->nports; ++i)
+                inst->ports[i]->set_value(inst->ports[i]->metadata()->start);
+        }
+
+    } /* namespace test */
+} /* namespace lsp */
+
+#endif /* PRIVATE_TEST_COMPRESSOR_INSTANCE_H_ */
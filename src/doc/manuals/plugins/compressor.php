@@ -164,3 +164,39 @@ keeping the same settings for the left and right channels.</p>
 	<li><b>Mix Dry/Wet</b> - the knob that controls this balance between mixed dry and wet signal (see <b>Mix Dry</b> and <b>Mix Wet</b>) and the dry (unprocessed) signal.</li>
 </ul>
 
+<p><b>Processing options</b> (controls below the time graph):</p>
+<ul>
+	<li><b>FB mode</b> - the processing mode of the <b>Feed-back</b> sidechain:</li>
+	<ul>
+		<li><b>Exact</b> - the sidechain is fed by the output of the compressor delayed by one sample.</li>
+		<li><b>Block</b> - the sidechain is fed by the output of the compressor delayed by 16 samples, the detector
+		is computed for short blocks of samples. This significantly reduces CPU usage for the cost of a slightly
+		slower reaction of the feed-back loop (0.33 ms at 48 kHz sample rate).</li>
+	</ul>
+	<li><b>Block size</b> - the maximum number of samples processed by each stage of the compressor at once:</li>
+	<ul>
+		<li><b>Auto</b> - the block size is selected according to the size of the block passed by the host.</li>
+		<li><b>Low latency</b> - blocks of 128 samples, best suited for small host blocks.</li>
+		<li><b>Balanced</b> - blocks of 512 samples.</li>
+		<li><b>Throughput</b> - blocks of 1024 samples, best suited for large host blocks and offline rendering.</li>
+	</ul>
+	<li><b>Gain</b> - the way the gain reduction is computed from the envelope of the sidechain signal:</li>
+	<ul>
+		<li><b>Exact</b> - the compression curve is evaluated for each sample.</li>
+		<li><b>Table</b> - the gain reduction is interpolated from the lookup table of the compression curve. The
+		deviation from the exact curve does not exceed 0.05 dB, the CPU usage is lower.</li>
+		<li><b>Control rate</b> - the envelope and the gain reduction are computed once per control step from the
+		peak of the sidechain signal over the step, and are linearly interpolated between steps. This gives the
+		lowest CPU usage for the cost of the reaction delayed by one step.</li>
+	</ul>
+	<li><b>Step</b> - the control step of the <b>Control rate</b> mode: 8, 16, 32 or 64 samples. In the <b>Auto</b>
+	mode the step is 1/16 of the attack time, but not more than 64 samples.</li>
+	<li><b>Error<?= $sm ?></b> - the upper bound of the deviation of the envelope computed at control rate from the
+	envelope computed for each sample, in percents of the level change of the sidechain signal.</li>
+	<li><b>SC decim</b> - runs the sidechain and the gain computer at the reduced sample rate. The decimation is
+	applied only when the sidechain is band-limited by the low-pass filter, the sidechain is not <b>Feed-back</b>,
+	the sidechain type is not <b>Peak</b> and the <b>Reactivity</b> is at least 10 ms. The sidechain filters are
+	applied at the original sample rate before the decimation. While the option is enabled, the plugin has
+	the additional latency of 15 samples that compensates the lag of the decimated detector, the latency does
+	not change with the settings of the sidechain.</li>
+</ul>
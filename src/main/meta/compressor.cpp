@@ -26,7 +26,7 @@
 
 #define LSP_PLUGINS_COMPRESSOR_VERSION_MAJOR       1
 #define LSP_PLUGINS_COMPRESSOR_VERSION_MINOR       0
-#define LSP_PLUGINS_COMPRESSOR_VERSION_MICRO       38
+#define LSP_PLUGINS_COMPRESSOR_VERSION_MICRO       39
 
 #define LSP_PLUGINS_COMPRESSOR_VERSION  \
     LSP_MODULE_VERSION( \
@@ -93,6 +93,48 @@ namespace lsp
             { NULL, NULL }
         };
 
+        static const port_item_t comp_fb_modes[] =
+        {
+            { "Exact",          "sidechain.feedback.exact" },
+            { "Block",          "sidechain.feedback.block" },
+            { NULL, NULL }
+        };
+
+        static const port_item_t comp_block_modes[] =
+        {
+            { "Auto",           "compressor.block.auto" },
+            { "Low latency",    "compressor.block.low_latency" },
+            { "Balanced",       "compressor.block.balanced" },
+            { "Throughput",     "compressor.block.throughput" },
+            { NULL, NULL }
+        };
+
+        static const port_item_t comp_history_zoom[] =
+        {
+            { "5 s",            "compressor.zoom.5s" },
+            { "30 s",           "compressor.zoom.30s" },
+            { "5 min",          "compressor.zoom.5m" },
+            { NULL, NULL }
+        };
+
+        static const port_item_t comp_gain_computers[] =
+        {
+            { "Exact",          "compressor.gain.exact" },
+            { "Table",          "compressor.gain.table" },
+            { "Control rate",   "compressor.gain.control" },
+            { NULL, NULL }
+        };
+
+        static const port_item_t comp_control_steps[] =
+        {
+            { "Auto",           "compressor.step.auto" },
+            { "8",              "compressor.step.8" },
+            { "16",             "compressor.step.16" },
+            { "32",             "compressor.step.32" },
+            { "64",             "compressor.step.64" },
+            { NULL, NULL }
+        };
+
         static const port_item_t comp_modes[] =
         {
             { "Down",       "compressor.down_ward" },
@@ -209,6 +251,19 @@ namespace lsp
         #define COMP_LINK(id, label, alias) \
             SWITCH(id, label, alias, 0.0f)
 
+        // Ports added after the initial release are appended to the end of the port list
+        // to keep indices of existing ports and settings of saved sessions
+        #define COMP_PROCESSING \
+            COMBO("fbm", "Feed-back processing mode", "FB mode", compressor_metadata::FBM_DEFAULT, comp_fb_modes), \
+            COMBO("bsize", "Processing block size", "Block size", compressor_metadata::BM_DEFAULT, comp_block_modes), \
+            COMBO("hzoom", "History zoom", "Zoom", compressor_metadata::HZ_DEFAULT, comp_history_zoom), \
+            COMBO("gcm", "Gain computer", "Gain comp", compressor_metadata::GC_DEFAULT, comp_gain_computers), \
+            COMBO("gcs", "Gain computer control step", "Ctl step", compressor_metadata::CS_DEFAULT, comp_control_steps), \
+            SWITCH("scdec", "Decimated sidechain detector", "SC decim", 0.0f)
+
+        #define COMP_PROCESSING_CHANNEL(id, label) \
+            METER_PERCENT("cre" id, "Control rate error" label)
+
         static const port_t compressor_mono_ports[] =
         {
             PORTS_MONO_PLUGIN,
@@ -218,6 +273,8 @@ namespace lsp
             COMP_SC_MONO_CHANNEL(comp_sc_type, 0),
             COMP_CHANNEL("", "", "", comp_modes),
             COMP_AUDIO_METER("", "", ""),
+            COMP_PROCESSING,
+            COMP_PROCESSING_CHANNEL("", ""),
 
             PORTS_END
         };
@@ -233,6 +290,8 @@ namespace lsp
             COMP_CHANNEL("", "", "", comp_modes),
             COMP_AUDIO_METER("_l", " Left", " L"),
             COMP_AUDIO_METER("_r", " Right", " R"),
+            COMP_PROCESSING,
+            COMP_PROCESSING_CHANNEL("", ""),
 
             PORTS_END
         };
@@ -250,6 +309,9 @@ namespace lsp
             COMP_CHANNEL("_r", " Right", " R", comp_modes),
             COMP_AUDIO_METER("_l", " Left", " L"),
             COMP_AUDIO_METER("_r", " Right", " R"),
+            COMP_PROCESSING,
+            COMP_PROCESSING_CHANNEL("_l", " Left"),
+            COMP_PROCESSING_CHANNEL("_r", " Right"),
 
             PORTS_END
         };
@@ -267,6 +329,9 @@ namespace lsp
             COMP_CHANNEL("_s", " Side", " S", comp_modes),
             COMP_AUDIO_METER("_m", " Mid", " M"),
             COMP_AUDIO_METER("_s", " Side", " S"),
+            COMP_PROCESSING,
+            COMP_PROCESSING_CHANNEL("_m", " Mid"),
+            COMP_PROCESSING_CHANNEL("_s", " Side"),
 
             PORTS_END
         };
@@ -281,6 +346,8 @@ namespace lsp
             COMP_SC_MONO_CHANNEL(comp_sc2_type, 2),
             COMP_CHANNEL("", "", "", comp_modes),
             COMP_AUDIO_METER("", "", ""),
+            COMP_PROCESSING,
+            COMP_PROCESSING_CHANNEL("", ""),
 
             PORTS_END
         };
@@ -297,6 +364,8 @@ namespace lsp
             COMP_CHANNEL("", "", "", comp_modes),
             COMP_AUDIO_METER("_l", " Left", " L"),
             COMP_AUDIO_METER("_r", " Right", " R"),
+            COMP_PROCESSING,
+            COMP_PROCESSING_CHANNEL("", ""),
 
             PORTS_END
         };
@@ -315,6 +384,9 @@ namespace lsp
             COMP_CHANNEL("_r", " Right", " R", comp_modes),
             COMP_AUDIO_METER("_l", " Left", " L"),
             COMP_AUDIO_METER("_r", " Right", " R"),
+            COMP_PROCESSING,
+            COMP_PROCESSING_CHANNEL("_l", " Left"),
+            COMP_PROCESSING_CHANNEL("_r", " Right"),
 
             PORTS_END
         };
@@ -333,6 +405,9 @@ namespace lsp
             COMP_CHANNEL("_s", " Side", " S", comp_modes),
             COMP_AUDIO_METER("_m", " Mid", " M"),
             COMP_AUDIO_METER("_s", " Side", " S"),
+            COMP_PROCESSING,
+            COMP_PROCESSING_CHANNEL("_m", " Mid"),
+            COMP_PROCESSING_CHANNEL("_s", " Side"),
 
             PORTS_END
         };
@@ -32,7 +32,17 @@ namespace lsp
 {
     namespace plugins
     {
-        static constexpr size_t COMP_BUF_SIZE       = 0x200;
+        static constexpr size_t COMP_BUF_SIZE       = meta::compressor_metadata::BLOCK_THROUGHPUT;  // Largest processing chunk
+        static constexpr size_t COMP_CACHE_LINE     = 0x40;
+        static constexpr float  LATENCY_FADE_TIME   = 5.0f;     // Crossfade time on latency change [ms]
+        static constexpr size_t SC_DECIM_LATENCY    = meta::compressor_metadata::SC_DECIM_MAX * 2 - 1;  // Lag of the decimated detector with maximum factor
+        static constexpr float  DISPLAY_FRAME_RATE  = 25.0f;    // Maximum rate of inline display redraw requests [Hz]
+
+        static const size_t history_ratios[] =
+        {
+            meta::compressor_metadata::TIME_ZOOM_RATIO_30S,
+            meta::compressor_metadata::TIME_ZOOM_RATIO_5M
+        };
 
         //-------------------------------------------------------------------------
         // Plugin factory
@@ -88,6 +98,7 @@ namespace lsp
             nMode           = mode;
             bSidechain      = sc;
             vChannels       = NULL;
+            vPorts          = NULL;
             vCurve          = NULL;
             vTime           = NULL;
             vEmptyBuffer    = NULL;
@@ -95,14 +106,55 @@ namespace lsp
             bClear          = false;
             bMSListen       = false;
             bStereoSplit    = false;
+            bFbBlock        = false;
+            bScDecim        = false;
             fInGain         = 1.0f;
+            nLatency        = 0;
+            nBlockMode      = meta::compressor_metadata::BM_DEFAULT;
+            nGainComp       = meta::compressor_metadata::GC_DEFAULT;
+            nCtlStep        = 0;
+            nHistoryZoom    = meta::compressor_metadata::HZ_DEFAULT;
+            nHostBlock      = 0;
+            nChunkSize      = meta::compressor_metadata::BLOCK_BALANCED;
+            nOldLatency     = 0;
+            nFade           = 0;
+            nFadeLength     = 1;
+            bDelaySync      = false;
             bUISync         = true;
+            pProcess        = NULL;
+            bMetering       = false;
+            nCurveVersion   = 1;
+            nDisplayPeriod  = 0;
+            nDisplayDelay   = 0;
+            nHistoryPeriod  = 1;
+            nHistoryPhase   = 0;
+            nHistoryPoints  = 0;
+
+            sIDCache.nWidth         = 0;
+            sIDCache.nHeight        = 0;
+            sIDCache.nCurveVersion  = 0;
+            sIDCache.nLines         = 0;
+            sIDCache.fDX            = 0.0f;
+            sIDCache.fDY            = 0.0f;
+            bIdle           = false;
+            nIdleSamples    = 0;
+            nIdleLimit      = 0;
+            fOutGain        = 1.0f;
+            nUpdate         = 0;
+            nReconfigs      = 0;
+            nReconfigTotal  = 0;
 
             pBypass         = NULL;
             pInGain         = NULL;
             pOutGain        = NULL;
             pPause          = NULL;
             pClear          = NULL;
+            pFbMode         = NULL;
+            pBlockMode      = NULL;
+            pHistoryZoom    = NULL;
+            pGainComp       = NULL;
+            pCtlStep        = NULL;
+            pScDecim        = NULL;
             pMSListen       = NULL;
             pStereoSplit    = NULL;
             pScSpSource     = NULL;
@@ -110,6 +162,7 @@ namespace lsp
             pData           = NULL;
             pIDisplay       = NULL;
 
+            sPremix.nRoutes     = 0;
             sPremix.fInToSc     = GAIN_AMP_M_INF_DB;
             sPremix.fInToLink   = GAIN_AMP_M_INF_DB;
             sPremix.fLinkToIn   = GAIN_AMP_M_INF_DB;
@@ -147,22 +200,33 @@ namespace lsp
             const size_t channels   = (nMode == CM_MONO) ? 1 : 2;
 
             // Allocate temporary buffers
-            size_t channel_size     = align_size(sizeof(channel_t) * channels, DEFAULT_ALIGN);
+            size_t channel_size     = align_size(sizeof(channel_t) * channels, COMP_CACHE_LINE);
+            size_t aux_size         = align_size(sizeof(channel_aux_t) * channels, COMP_CACHE_LINE);
+            size_t ports_size       = align_size(sizeof(channel_ports_t) * channels, DEFAULT_ALIGN);
             size_t buf_size         = COMP_BUF_SIZE * sizeof(float);
+            size_t fb_size          = align_size(meta::compressor_metadata::FEEDBACK_BLOCK * sizeof(float), DEFAULT_ALIGN);
             size_t curve_size       = (meta::compressor_metadata::CURVE_MESH_SIZE) * sizeof(float);
             size_t history_size     = (meta::compressor_metadata::TIME_MESH_SIZE) * sizeof(float);
             size_t allocate         = channel_size +
+                                      aux_size +
+                                      ports_size +
                                       buf_size +
-                                      buf_size * channels * 5 +
+                                      buf_size * channels * 6 +
                                       buf_size * channels * 3 +
+                                      fb_size * channels +
+                                      curve_size * channels +
                                       curve_size +
                                       history_size;
 
-            uint8_t *ptr            = alloc_aligned<uint8_t>(pData, allocate);
+            // Hot data of all channels starts at the cache line boundary, the rest of channel state
+            // and port bindings are kept apart
+            uint8_t *ptr            = alloc_aligned<uint8_t>(pData, allocate, COMP_CACHE_LINE);
             if (ptr == NULL)
                 return;
 
             vChannels               = advance_ptr_bytes<channel_t>(ptr, channel_size);
+            channel_aux_t *vAux     = advance_ptr_bytes<channel_aux_t>(ptr, aux_size);
+            vPorts                  = advance_ptr_bytes<channel_ports_t>(ptr, ports_size);
             vCurve                  = advance_ptr_bytes<float>(ptr, curve_size);
             vTime                   = advance_ptr_bytes<float>(ptr, history_size);
             vEmptyBuffer            = advance_ptr_bytes<float>(ptr, buf_size);
@@ -180,79 +244,134 @@ namespace lsp
             {
                 // Construct the channel
                 channel_t *c = &vChannels[i];
-                c->sBypass.construct();
+                channel_aux_t *ca = &vAux[i];
+                channel_ports_t *cp = &vPorts[i];
+                c->pAux             = ca;
+                c->pPorts           = cp;
+                ca->sBypass.construct();
                 c->sSC.construct();
-                c->sSCEq.construct();
+                ca->sSCEq.construct();
+                ca->sDecim.construct();
+                ca->sDSC.construct();
+                for (size_t j=0; j<SidechainDecimator::CHANNELS_MAX; ++j)
+                    ca->vDSCEq[j].construct();
                 c->sComp.construct();
-                c->sLaDelay.construct();
-                c->sInDelay.construct();
-                c->sOutDelay.construct();
-                c->sDryDelay.construct();
+                c->sGainComp.construct();
+                ca->sDGain.construct();
+                c->sDelay.construct();
                 for (size_t j=0; j<G_TOTAL; ++j)
-                    c->sGraph[j].construct();
+                {
+                    ca->sGraph[j].construct();
+                    ca->sHistory[j].construct();
+                }
 
                 // Init the channel
                 if (!c->sSC.init(channels, meta::compressor_metadata::REACTIVITY_MAX))
                     return;
-                if (!c->sSCEq.init(2, 12))
+                if (!ca->sSCEq.init(2, 12))
+                    return;
+                ca->sSCEq.set_mode(dspu::EQM_IIR);
+                c->sSC.set_pre_equalizer(&ca->sSCEq);
+                if (!c->sGainComp.init())
+                    return;
+
+                // Init the decimated detector
+                if (!ca->sDecim.init(channels, DS_TOTAL, meta::compressor_metadata::SC_DECIM_MAX, COMP_BUF_SIZE))
+                    return;
+                if (!ca->sDSC.init(channels, meta::compressor_metadata::REACTIVITY_MAX))
                     return;
-                c->sSCEq.set_mode(dspu::EQM_IIR);
-                c->sSC.set_pre_equalizer(&c->sSCEq);
+                for (size_t j=0; j<channels; ++j)
+                {
+                    if (!ca->vDSCEq[j].init(2, 12))
+                        return;
+                    ca->vDSCEq[j].set_mode(dspu::EQM_IIR);
+                    ca->sDecim.set_pre_equalizer(j, &ca->vDSCEq[j]);
+                }
+                if (!ca->sDGain.init())
+                    return;
+            #ifndef LSP_PLUGINS_COMPRESSOR_HEADLESS
+                for (size_t j=0; j<G_TOTAL; ++j)
+                {
+                    if (!ca->sHistory[j].init(meta::compressor_metadata::TIME_MESH_SIZE, history_ratios, meta::compressor_metadata::HZ_TOTAL - 1))
+                        return;
+                }
+            #endif /* LSP_PLUGINS_COMPRESSOR_HEADLESS */
 
                 c->vIn              = advance_ptr_bytes<float>(ptr, buf_size);
                 c->vOut             = advance_ptr_bytes<float>(ptr, buf_size);
-                c->vSc              = advance_ptr_bytes<float>(ptr, buf_size);
-                c->vEnv             = advance_ptr_bytes<float>(ptr, buf_size);
-                c->vGain            = advance_ptr_bytes<float>(ptr, buf_size);
+                ca->vScBuf          = advance_ptr_bytes<float>(ptr, buf_size);
+                ca->vEnvBuf         = advance_ptr_bytes<float>(ptr, buf_size);
+                ca->vGainBuf        = advance_ptr_bytes<float>(ptr, buf_size);
+                c->vSc              = ca->vScBuf;
+                c->vEnv             = ca->vEnvBuf;
+                c->vGain            = ca->vGainBuf;
+                c->vDry             = advance_ptr_bytes<float>(ptr, buf_size);
+                c->vFbHistory       = advance_ptr_bytes<float>(ptr, fb_size);
+                ca->vGainCurve      = advance_ptr_bytes<float>(ptr, curve_size);
+                ca->pGainCurve      = NULL;
+                c->vDelayIn         = c->vIn;
+                c->vDelayDry        = NULL;
+                c->nLookahead       = 0;
+                c->nOldLookahead    = 0;
+                c->nNewLookahead    = 0;
+                c->nScPad           = 0;
                 c->bScListen        = false;
-                c->nSync            = S_ALL;
+                ca->nSync           = S_ALL;
                 c->nScType          = SCT_FEED_FORWARD;
-                c->fMakeup          = 1.0f;
+                ca->fMakeup         = 1.0f;
                 c->fFeedback        = 0.0f;
                 c->fDryGain         = 1.0f;
                 c->fWetGain         = 0.0f;
-                c->fDotIn           = 0.0f;
-                c->fDotOut          = 0.0f;
-
-                c->pIn              = NULL;
-                c->pOut             = NULL;
-                c->pSC              = NULL;
-                c->pShmIn           = NULL;
+                ca->fDotIn          = 0.0f;
+                ca->fDotOut         = 0.0f;
+                c->fEnvLevel        = 0.0f;
+                c->fGainLevel       = 1.0f;
+                c->fIdleLevel       = GAIN_AMP_M_120_DB;
+                ca->nUpdate         = U_ALL;
+                ca->nScSource       = 0;
+                for (size_t j=0; j<CP_TOTAL; ++j)
+                    cp->vParams[j]      = 0.0f;
+
+                cp->pIn             = NULL;
+                cp->pOut            = NULL;
+                cp->pSC             = NULL;
+                cp->pShmIn          = NULL;
 
                 for (size_t j=0; j<G_TOTAL; ++j)
-                    c->pGraph[j]        = NULL;
+                    cp->pGraph[j]       = NULL;
 
                 for (size_t j=0; j<M_TOTAL; ++j)
-                    c->pMeter[j]        = NULL;
-
-                c->pScType          = NULL;
-                c->pScMode          = NULL;
-                c->pScLookahead     = NULL;
-                c->pScListen        = NULL;
-                c->pScSource        = NULL;
-                c->pScReactivity    = NULL;
-                c->pScPreamp        = NULL;
-                c->pScHpfMode       = NULL;
-                c->pScHpfFreq       = NULL;
-                c->pScLpfMode       = NULL;
-                c->pScLpfFreq       = NULL;
-
-                c->pMode            = NULL;
-                c->pAttackLvl       = NULL;
-                c->pReleaseLvl      = NULL;
-                c->pAttackTime      = NULL;
-                c->pReleaseTime     = NULL;
-                c->pHoldTime        = NULL;
-                c->pRatio           = NULL;
-                c->pKnee            = NULL;
-                c->pBThresh         = NULL;
-                c->pBoost           = NULL;
-                c->pMakeup          = NULL;
-                c->pDryGain         = NULL;
-                c->pWetGain         = NULL;
-                c->pDryWet          = NULL;
-                c->pCurve           = NULL;
-                c->pReleaseOut      = NULL;
+                    cp->pMeter[j]       = NULL;
+
+                cp->pScType         = NULL;
+                cp->pScMode         = NULL;
+                cp->pScLookahead    = NULL;
+                cp->pScListen       = NULL;
+                cp->pScSource       = NULL;
+                cp->pScReactivity   = NULL;
+                cp->pScPreamp       = NULL;
+                cp->pScHpfMode      = NULL;
+                cp->pScHpfFreq      = NULL;
+                cp->pScLpfMode      = NULL;
+                cp->pScLpfFreq      = NULL;
+
+                cp->pMode           = NULL;
+                cp->pAttackLvl      = NULL;
+                cp->pReleaseLvl     = NULL;
+                cp->pAttackTime     = NULL;
+                cp->pReleaseTime    = NULL;
+                cp->pHoldTime       = NULL;
+                cp->pRatio          = NULL;
+                cp->pKnee           = NULL;
+                cp->pBThresh        = NULL;
+                cp->pBoost          = NULL;
+                cp->pMakeup         = NULL;
+                cp->pDryGain        = NULL;
+                cp->pWetGain        = NULL;
+                cp->pDryWet         = NULL;
+                cp->pCurve          = NULL;
+                cp->pReleaseOut     = NULL;
+                cp->pCtlError       = NULL;
             }
 
             lsp_assert(ptr <= &pData[allocate]);
@@ -263,26 +382,26 @@ namespace lsp
             // Input ports
             lsp_trace("Binding input ports");
             for (size_t i=0; i<channels; ++i)
-                BIND_PORT(vChannels[i].pIn);
+                BIND_PORT(vChannels[i].pPorts->pIn);
 
             // Output ports
             lsp_trace("Binding output ports");
             for (size_t i=0; i<channels; ++i)
-                BIND_PORT(vChannels[i].pOut);
+                BIND_PORT(vChannels[i].pPorts->pOut);
 
             // Sidechain ports
             if (bSidechain)
             {
                 lsp_trace("Binding sidechain ports");
                 for (size_t i=0; i<channels; ++i)
-                    BIND_PORT(vChannels[i].pSC);
+                    BIND_PORT(vChannels[i].pPorts->pSC);
             }
 
             // Shared memory link
             lsp_trace("Binding shared memory link");
             SKIP_PORT("Shared memory link name");
             for (size_t i=0; i<channels; ++i)
-                BIND_PORT(vChannels[i].pShmIn);
+                BIND_PORT(vChannels[i].pPorts->pShmIn);
 
             // Pre-mixing ports
             lsp_trace("Binding pre-mix ports");
@@ -320,37 +439,37 @@ namespace lsp
             lsp_trace("Binding sidechain ports");
             for (size_t i=0; i<channels; ++i)
             {
-                channel_t *c = &vChannels[i];
+                channel_ports_t *cp = vChannels[i].pPorts;
 
                 if ((i > 0) && (nMode == CM_STEREO))
                 {
-                    channel_t *sc       = &vChannels[0];
-                    c->pScType          = sc->pScType;
-                    c->pScSource        = sc->pScSource;
-                    c->pScLookahead     = sc->pScLookahead;
-                    c->pScMode          = sc->pScMode;
-                    c->pScListen        = sc->pScListen;
-                    c->pScReactivity    = sc->pScReactivity;
-                    c->pScPreamp        = sc->pScPreamp;
-                    c->pScHpfMode       = sc->pScHpfMode;
-                    c->pScHpfFreq       = sc->pScHpfFreq;
-                    c->pScLpfMode       = sc->pScLpfMode;
-                    c->pScLpfFreq       = sc->pScLpfFreq;
+                    channel_ports_t *sp = vChannels[0].pPorts;
+                    cp->pScType         = sp->pScType;
+                    cp->pScSource       = sp->pScSource;
+                    cp->pScLookahead    = sp->pScLookahead;
+                    cp->pScMode         = sp->pScMode;
+                    cp->pScListen       = sp->pScListen;
+                    cp->pScReactivity   = sp->pScReactivity;
+                    cp->pScPreamp       = sp->pScPreamp;
+                    cp->pScHpfMode      = sp->pScHpfMode;
+                    cp->pScHpfFreq      = sp->pScHpfFreq;
+                    cp->pScLpfMode      = sp->pScLpfMode;
+                    cp->pScLpfFreq      = sp->pScLpfFreq;
                 }
                 else
                 {
-                    BIND_PORT(c->pScType);
-                    BIND_PORT(c->pScMode);
-                    BIND_PORT(c->pScLookahead);
-                    BIND_PORT(c->pScListen);
+                    BIND_PORT(cp->pScType);
+                    BIND_PORT(cp->pScMode);
+                    BIND_PORT(cp->pScLookahead);
+                    BIND_PORT(cp->pScListen);
                     if (nMode != CM_MONO)
-                        BIND_PORT(c->pScSource);
-                    BIND_PORT(c->pScReactivity);
-                    BIND_PORT(c->pScPreamp);
-                    BIND_PORT(c->pScHpfMode);
-                    BIND_PORT(c->pScHpfFreq);
-                    BIND_PORT(c->pScLpfMode);
-                    BIND_PORT(c->pScLpfFreq);
+                        BIND_PORT(cp->pScSource);
+                    BIND_PORT(cp->pScReactivity);
+                    BIND_PORT(cp->pScPreamp);
+                    BIND_PORT(cp->pScHpfMode);
+                    BIND_PORT(cp->pScHpfFreq);
+                    BIND_PORT(cp->pScLpfMode);
+                    BIND_PORT(cp->pScLpfFreq);
                 }
             }
 
@@ -358,45 +477,45 @@ namespace lsp
             lsp_trace("Binding compressor ports");
             for (size_t i=0; i<channels; ++i)
             {
-                channel_t *c = &vChannels[i];
+                channel_ports_t *cp = vChannels[i].pPorts;
 
                 if ((i > 0) && (nMode == CM_STEREO))
                 {
-                    channel_t *sc       = &vChannels[0];
-
-                    c->pMode            = sc->pMode;
-                    c->pAttackLvl       = sc->pAttackLvl;
-                    c->pAttackTime      = sc->pAttackTime;
-                    c->pReleaseLvl      = sc->pReleaseLvl;
-                    c->pReleaseTime     = sc->pReleaseTime;
-                    c->pHoldTime        = sc->pHoldTime;
-                    c->pRatio           = sc->pRatio;
-                    c->pKnee            = sc->pKnee;
-                    c->pBThresh         = sc->pBThresh;
-                    c->pBoost           = sc->pBoost;
-                    c->pMakeup          = sc->pMakeup;
-                    c->pDryGain         = sc->pDryGain;
-                    c->pWetGain         = sc->pWetGain;
-                    c->pDryWet          = sc->pDryWet;
+                    channel_ports_t *sp = vChannels[0].pPorts;
+
+                    cp->pMode           = sp->pMode;
+                    cp->pAttackLvl      = sp->pAttackLvl;
+                    cp->pAttackTime     = sp->pAttackTime;
+                    cp->pReleaseLvl     = sp->pReleaseLvl;
+                    cp->pReleaseTime    = sp->pReleaseTime;
+                    cp->pHoldTime       = sp->pHoldTime;
+                    cp->pRatio          = sp->pRatio;
+                    cp->pKnee           = sp->pKnee;
+                    cp->pBThresh        = sp->pBThresh;
+                    cp->pBoost          = sp->pBoost;
+                    cp->pMakeup         = sp->pMakeup;
+                    cp->pDryGain        = sp->pDryGain;
+                    cp->pWetGain        = sp->pWetGain;
+                    cp->pDryWet         = sp->pDryWet;
                 }
                 else
                 {
-                    BIND_PORT(c->pMode);
-                    BIND_PORT(c->pAttackLvl);
-                    BIND_PORT(c->pAttackTime);
-                    BIND_PORT(c->pReleaseLvl);
-                    BIND_PORT(c->pReleaseTime);
-                    BIND_PORT(c->pHoldTime);
-                    BIND_PORT(c->pRatio);
-                    BIND_PORT(c->pKnee);
-                    BIND_PORT(c->pBThresh);
-                    BIND_PORT(c->pBoost);
-                    BIND_PORT(c->pMakeup);
-                    BIND_PORT(c->pDryGain);
-                    BIND_PORT(c->pWetGain);
-                    BIND_PORT(c->pDryWet);
-                    BIND_PORT(c->pReleaseOut);
-                    BIND_PORT(c->pCurve);
+                    BIND_PORT(cp->pMode);
+                    BIND_PORT(cp->pAttackLvl);
+                    BIND_PORT(cp->pAttackTime);
+                    BIND_PORT(cp->pReleaseLvl);
+                    BIND_PORT(cp->pReleaseTime);
+                    BIND_PORT(cp->pHoldTime);
+                    BIND_PORT(cp->pRatio);
+                    BIND_PORT(cp->pKnee);
+                    BIND_PORT(cp->pBThresh);
+                    BIND_PORT(cp->pBoost);
+                    BIND_PORT(cp->pMakeup);
+                    BIND_PORT(cp->pDryGain);
+                    BIND_PORT(cp->pWetGain);
+                    BIND_PORT(cp->pDryWet);
+                    BIND_PORT(cp->pReleaseOut);
+                    BIND_PORT(cp->pCurve);
                 }
             }
 
@@ -404,7 +523,7 @@ namespace lsp
             lsp_trace("Binding history and meter ports");
             for (size_t i=0; i<channels; ++i)
             {
-                channel_t *c = &vChannels[i];
+                channel_ports_t *cp = vChannels[i].pPorts;
 
                 // Skip meters visibility controls
                 SKIP_PORT("Sidechain switch");
@@ -413,20 +532,37 @@ namespace lsp
                 SKIP_PORT("Input switch");
                 SKIP_PORT("Output switch");
 
-                BIND_PORT(c->pGraph[G_SC]);
-                BIND_PORT(c->pGraph[G_ENV]);
-                BIND_PORT(c->pGraph[G_GAIN]);
-                BIND_PORT(c->pGraph[G_IN]);
-                BIND_PORT(c->pGraph[G_OUT]);
-                BIND_PORT(c->pMeter[M_SC]);
-                BIND_PORT(c->pMeter[M_CURVE]);
-                BIND_PORT(c->pMeter[M_ENV]);
-                BIND_PORT(c->pMeter[M_GAIN]);
-                BIND_PORT(c->pMeter[M_IN]);
-                BIND_PORT(c->pMeter[M_OUT]);
+                BIND_PORT(cp->pGraph[G_SC]);
+                BIND_PORT(cp->pGraph[G_ENV]);
+                BIND_PORT(cp->pGraph[G_GAIN]);
+                BIND_PORT(cp->pGraph[G_IN]);
+                BIND_PORT(cp->pGraph[G_OUT]);
+                BIND_PORT(cp->pMeter[M_SC]);
+                BIND_PORT(cp->pMeter[M_CURVE]);
+                BIND_PORT(cp->pMeter[M_ENV]);
+                BIND_PORT(cp->pMeter[M_GAIN]);
+                BIND_PORT(cp->pMeter[M_IN]);
+                BIND_PORT(cp->pMeter[M_OUT]);
+            }
+
+            // Bind processing ports, they are placed at the end of the port list
+            lsp_trace("Binding processing ports");
+            BIND_PORT(pFbMode);
+            BIND_PORT(pBlockMode);
+            BIND_PORT(pHistoryZoom);
+            BIND_PORT(pGainComp);
+            BIND_PORT(pCtlStep);
+            BIND_PORT(pScDecim);
+            for (size_t i=0; i<channels; ++i)
+            {
+                if ((i > 0) && (nMode == CM_STEREO))
+                    continue;
+                BIND_PORT(vChannels[i].pPorts->pCtlError);
             }
 
             dsp::fill_zero(vEmptyBuffer, COMP_BUF_SIZE);
+            for (size_t i=0; i<channels; ++i)
+                dsp::fill_zero(vChannels[i].vFbHistory, meta::compressor_metadata::FEEDBACK_BLOCK);
 
             // Initialize curve (logarithmic) in range of -72 .. +24 db
             float delta = (meta::compressor_metadata::CURVE_DB_MAX - meta::compressor_metadata::CURVE_DB_MIN) / (meta::compressor_metadata::CURVE_MESH_SIZE-1);
@@ -437,6 +573,9 @@ namespace lsp
             delta       = meta::compressor_metadata::TIME_HISTORY_MAX / (meta::compressor_metadata::TIME_MESH_SIZE - 1);
             for (size_t i=0; i<meta::compressor_metadata::TIME_MESH_SIZE; ++i)
                 vTime[i]    = meta::compressor_metadata::TIME_HISTORY_MAX - i*delta;
+
+            // Select default processing routine
+            pProcess    = select_process_func(0);
         }
 
         void compressor::destroy()
@@ -454,19 +593,26 @@ namespace lsp
                 {
                     channel_t *c = &vChannels[i];
 
-                    c->sBypass.destroy();
+                    c->pAux->sBypass.destroy();
                     c->sSC.destroy();
-                    c->sSCEq.destroy();
+                    c->pAux->sSCEq.destroy();
+                    c->pAux->sDecim.destroy();
+                    c->pAux->sDSC.destroy();
+                    for (size_t j=0; j<SidechainDecimator::CHANNELS_MAX; ++j)
+                        c->pAux->vDSCEq[j].destroy();
                     c->sComp.destroy();
-                    c->sLaDelay.destroy();
-                    c->sInDelay.destroy();
-                    c->sOutDelay.destroy();
-                    c->sDryDelay.destroy();
+                    c->sGainComp.destroy();
+                    c->pAux->sDGain.destroy();
+                    c->sDelay.destroy();
                     for (size_t j=0; j<G_TOTAL; ++j)
-                        c->sGraph[j].destroy();
+                    {
+                        c->pAux->sGraph[j].destroy();
+                        c->pAux->sHistory[j].destroy();
+                    }
                 }
 
                 vChannels = NULL;
+                vPorts = NULL;
             }
 
             if (pData != NULL)
@@ -486,25 +632,44 @@ namespace lsp
         {
             size_t samples_per_dot  = dspu::seconds_to_samples(sr, meta::compressor_metadata::TIME_HISTORY_MAX / meta::compressor_metadata::TIME_MESH_SIZE);
             size_t channels         = (nMode == CM_MONO) ? 1 : 2;
-            size_t max_delay        = dspu::millis_to_samples(fSampleRate, meta::compressor_metadata::LOOKAHEAD_MAX);
+            // The lookahead delay line also compensates the lag of the decimated detector
+            size_t max_delay        = dspu::millis_to_samples(fSampleRate, meta::compressor_metadata::LOOKAHEAD_MAX) +
+                                      SC_DECIM_LATENCY;
+
+            // Delay lines are cleared before use, re-apply latency after they are re-allocated
+            nLatency                = 0;
+            nHostBlock              = 0;
+            nFade                   = 0;
+            bDelaySync              = false;
+            nFadeLength             = lsp_max(dspu::millis_to_samples(sr, LATENCY_FADE_TIME), size_t(1));
+            nDisplayPeriod          = sr / DISPLAY_FRAME_RATE;
+            nDisplayDelay           = 0;
+            nHistoryPeriod          = lsp_max(samples_per_dot, size_t(1));
+            nHistoryPhase           = 0;
+            nHistoryPoints          = 0;
 
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c = &vChannels[i];
-                c->sBypass.init(sr);
+                c->pAux->nUpdate    = U_ALL;
+                c->pAux->sBypass.init(sr);
                 c->sComp.set_sample_rate(sr);
                 c->sSC.set_sample_rate(sr);
-                c->sSCEq.set_sample_rate(sr);
-                c->sLaDelay.init(max_delay);
-                c->sInDelay.init(max_delay);
-                c->sOutDelay.init(max_delay);
-                c->sDryDelay.init(max_delay);
-
+                c->pAux->sSCEq.set_sample_rate(sr);
+                c->pAux->sDSC.set_sample_rate(sr / c->pAux->sDecim.factor());
+                for (size_t j=0; j<channels; ++j)
+                    c->pAux->vDSCEq[j].set_sample_rate(sr);
+                c->sDelay.init(DL_TOTAL, max_delay, COMP_BUF_SIZE);
+                c->nLookahead       = 0;
+
+            #ifndef LSP_PLUGINS_COMPRESSOR_HEADLESS
                 for (size_t j=0; j<G_TOTAL; ++j)
                 {
                     const float dfl = (j == G_GAIN) ? GAIN_AMP_0_DB : GAIN_AMP_M_INF_DB;
-                    c->sGraph[j].init(meta::compressor_metadata::TIME_MESH_SIZE, samples_per_dot, dfl);
+                    c->pAux->sGraph[j].init(meta::compressor_metadata::TIME_MESH_SIZE, samples_per_dot, dfl);
+                    c->pAux->sHistory[j].clear(dfl);
                 }
+            #endif /* LSP_PLUGINS_COMPRESSOR_HEADLESS */
             }
         }
 
@@ -600,6 +765,79 @@ namespace lsp
             sPremix.fLinkToSc   = (sPremix.pLinkToSc != NULL)   ? sPremix.pLinkToSc->value()    : GAIN_AMP_M_INF_DB;
             sPremix.fScToIn     = (sPremix.pScToIn != NULL)     ? sPremix.pScToIn->value()      : GAIN_AMP_M_INF_DB;
             sPremix.fScToLink   = (sPremix.pScToLink != NULL)   ? sPremix.pScToLink->value()    : GAIN_AMP_M_INF_DB;
+
+            // Compile the set of active routes, the sidechain signal is the input signal without sidechain
+            uint32_t routes     = 0;
+            if (sPremix.fScToIn > GAIN_AMP_M_INF_DB)
+                routes             |= PR_SC_TO_IN;
+            if (sPremix.fLinkToIn > GAIN_AMP_M_INF_DB)
+                routes             |= PR_LINK_TO_IN;
+            if (sPremix.fInToSc > GAIN_AMP_M_INF_DB)
+                routes             |= PR_IN_TO_SC;
+            if (sPremix.fLinkToSc > GAIN_AMP_M_INF_DB)
+                routes             |= PR_LINK_TO_SC;
+            if (sPremix.fInToLink > GAIN_AMP_M_INF_DB)
+                routes             |= PR_IN_TO_LINK;
+            if (sPremix.fScToLink > GAIN_AMP_M_INF_DB)
+                routes             |= PR_SC_TO_LINK;
+            if (!bSidechain)
+                routes             &= ~uint32_t(PR_SC_TO_IN | PR_IN_TO_SC | PR_SC_TO_LINK);
+
+            sPremix.nRoutes     = routes;
+        }
+
+        uint32_t compressor::fetch_params(channel_t *c)
+        {
+            typedef struct param_t
+            {
+                plug::IPort    *channel_ports_t::*pPort;    // Port of the channel
+                uint32_t        nUpdate;                    // Subsystem affected by the parameter
+            } param_t;
+
+            static const param_t params[] =
+            {
+                { &channel_ports_t::pScType,          U_SC            },
+                { &channel_ports_t::pScMode,          U_SC            },
+                { &channel_ports_t::pScReactivity,    U_SC            },
+                { &channel_ports_t::pScPreamp,        U_SC            },
+                { &channel_ports_t::pScHpfMode,       U_SC_EQ         },
+                { &channel_ports_t::pScHpfFreq,       U_SC_EQ         },
+                { &channel_ports_t::pScLpfMode,       U_SC_EQ         },
+                { &channel_ports_t::pScLpfFreq,       U_SC_EQ         },
+                { &channel_ports_t::pScLookahead,     U_LOOKAHEAD     },
+                { &channel_ports_t::pMode,            U_COMP          },
+                { &channel_ports_t::pAttackLvl,       U_COMP          },
+                { &channel_ports_t::pReleaseLvl,      U_COMP          },
+                { &channel_ports_t::pAttackTime,      U_COMP          },
+                { &channel_ports_t::pReleaseTime,     U_COMP          },
+                { &channel_ports_t::pHoldTime,        U_COMP          },
+                { &channel_ports_t::pRatio,           U_COMP          },
+                { &channel_ports_t::pKnee,            U_COMP          },
+                { &channel_ports_t::pBThresh,         U_COMP          },
+                { &channel_ports_t::pBoost,           U_COMP          },
+                { &channel_ports_t::pMakeup,          U_GAIN          },
+                { &channel_ports_t::pDryGain,         U_GAIN          },
+                { &channel_ports_t::pWetGain,         U_GAIN          },
+                { &channel_ports_t::pDryWet,          U_GAIN          },
+            };
+            static_assert(sizeof(params) / sizeof(param_t) == CP_TOTAL, "Invalid number of channel parameters");
+
+            // Compare current values of ports with the last applied ones
+            channel_ports_t *cp = c->pPorts;
+            uint32_t update     = c->pAux->nUpdate;
+            for (size_t i=0; i<CP_TOTAL; ++i)
+            {
+                plug::IPort *p      = cp->*(params[i].pPort);
+                const float value   = (p != NULL) ? p->value() : 0.0f;
+                if (value != cp->vParams[i])
+                {
+                    cp->vParams[i]      = value;
+                    update             |= params[i].nUpdate;
+                }
+            }
+            c->pAux->nUpdate    = 0;
+
+            return update;
         }
 
         void compressor::update_settings()
@@ -612,116 +850,356 @@ namespace lsp
             update_premix();
 
             // Global parameters
+            const bool split    = (pStereoSplit != NULL) ? pStereoSplit->value() >= 0.5f : false;
+            float out_gain      = pOutGain->value();
+            uint32_t update_all = 0;
+            if (split != bStereoSplit)
+                update_all         |= U_SC;
+            if (out_gain != fOutGain)
+                update_all         |= U_GAIN;
+
             bPause          = pPause->value() >= 0.5f;
             bClear          = pClear->value() >= 0.5f;
             bMSListen       = (pMSListen != NULL) ? pMSListen->value() >= 0.5f : false;
-            bStereoSplit    = (pStereoSplit != NULL) ? pStereoSplit->value() >= 0.5f : false;
+            if ((nMode == CM_STEREO) && (split != bStereoSplit) && (split))
+            {
+                // The detector of the second channel was not running while channels were linked
+                reset_detector(&vChannels[1]);
+            }
+            bStereoSplit    = split;
+            if (channels > 1)
+                link_channels((nMode == CM_STEREO) && (!bStereoSplit));
+            const bool fb_block     = size_t(pFbMode->value()) == meta::compressor_metadata::FBM_BLOCK;
+            if ((fb_block) && (!bFbBlock))
+            {
+                // The output history is kept only in block mode, initialize it with the last output sample
+                for (size_t i=0; i<channels; ++i)
+                    dsp::fill(vChannels[i].vFbHistory, vChannels[i].fFeedback, meta::compressor_metadata::FEEDBACK_BLOCK);
+            }
+            bFbBlock        = fb_block;
+            const bool sc_decim     = pScDecim->value() >= 0.5f;
+            if (sc_decim != bScDecim)
+                update_all         |= U_LOOKAHEAD;
+            bScDecim        = sc_decim;
+            nBlockMode      = size_t(pBlockMode->value());
+            const size_t gain_comp  = size_t(pGainComp->value());
+            const bool gc_changed   = gain_comp != nGainComp;
+            nGainComp       = gain_comp;
+            const size_t ctl_step   = size_t(pCtlStep->value());
+            nCtlStep        = (ctl_step != meta::compressor_metadata::CS_AUTO) ? size_t(4) << ctl_step : 0;
+            const size_t zoom   = size_t(pHistoryZoom->value());
+            if (zoom != nHistoryZoom)
+            {
+                nHistoryZoom    = zoom;
+                bUISync         = true;
+            }
             fInGain         = pInGain->value();
-            float out_gain  = pOutGain->value();
-            size_t latency  = 0;
+            fOutGain        = out_gain;
+
+            nUpdate         = 0;
+            nReconfigs      = 0;
 
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c    = &vChannels[i];
-                plug::IPort *sc = (bStereoSplit) ? pScSpSource : c->pScSource;
+                plug::IPort *sc = (bStereoSplit) ? pScSpSource : c->pPorts->pScSource;
                 size_t sc_src   = (sc != NULL) ? size_t(sc->value()) : size_t(dspu::SCS_MIDDLE);
 
+                // Determine what subsystems need to be reconfigured
+                uint32_t update = fetch_params(c) | update_all;
+                if (c->pAux->nScSource != sc_src)
+                {
+                    c->pAux->nScSource    = sc_src;
+                    update         |= U_SC;
+                }
+
                 // Update bypass settings
-                c->sBypass.set_bypass(bypass);
+                c->pAux->sBypass.set_bypass(bypass);
+                c->bScListen    = c->pPorts->pScListen->value() >= 0.5f;
+
+                // Update decimation factor. The factor depends on automatable parameters, so the
+                // latency does not depend on it: while the decimation is allowed, the lookahead
+                // reserves the lag of the maximum factor and the gain of a smaller factor is padded
+                // by the delay line. The gain computers continue from the current envelope.
+                bool gc_update      = gc_changed;
+                bool gc_reset       = gc_changed;
+                const size_t decim  = decimation_factor(c);
+                if (decim != c->pAux->sDecim.factor())
+                {
+                    gc_update           = true;
+                    gc_reset            = true;
+                    c->pAux->sDecim.set_factor(decim);
+                    c->pAux->sDSC.set_sample_rate(fSampleRate / decim);
+                    update         |= U_SC;
+                }
+                c->nScPad       = (bScDecim) ? SC_DECIM_LATENCY - c->pAux->sDecim.latency() : 0;
 
                 // Update sidechain settings
-                c->nScType      = decode_sidechain_type(c->pScType->value());
-                c->bScListen    = c->pScListen->value() >= 0.5f;
-
-                c->sSC.set_gain(c->pScPreamp->value());
-                c->sSC.set_mode((c->pScMode != NULL) ? size_t(c->pScMode->value()) : size_t(dspu::SCM_RMS));
-                c->sSC.set_source(decode_sidechain_source(sc_src, bStereoSplit, i));
-                c->sSC.set_reactivity(c->pScReactivity->value());
-                c->sSC.set_stereo_mode(((nMode == CM_MS) && (!use_sidechain(*c))) ? dspu::SCSM_MIDSIDE : dspu::SCSM_STEREO);
-
-                // Setup hi-pass filter for sidechain
-                size_t hp_slope = size_t(c->pScHpfMode->value()) * 2;
-                fp.nType        = (hp_slope > 0) ? dspu::FLT_BT_BWC_HIPASS : dspu::FLT_NONE;
-                fp.fFreq        = c->pScHpfFreq->value();
-                fp.fFreq2       = fp.fFreq;
-                fp.fGain        = 1.0f;
-                fp.nSlope       = hp_slope;
-                fp.fQuality     = 0.0f;
-                c->sSCEq.set_params(0, &fp);
-
-                // Setup low-pass filter for sidechain
-                size_t lp_slope = size_t(c->pScLpfMode->value()) * 2;
-                fp.nType        = (lp_slope > 0) ? dspu::FLT_BT_BWC_LOPASS : dspu::FLT_NONE;
-                fp.fFreq        = c->pScLpfFreq->value();
-                fp.fFreq2       = fp.fFreq;
-                fp.fGain        = 1.0f;
-                fp.nSlope       = lp_slope;
-                fp.fQuality     = 0.0f;
-                c->sSCEq.set_params(1, &fp);
-
-                // Update delay and estimate overall delay
-                size_t delay    = dspu::millis_to_samples(fSampleRate, (c->pScLookahead != NULL) ? c->pScLookahead->value() : 0);
-                c->sLaDelay.set_delay(delay);
-                latency         = lsp_max(latency, delay);
+                if (update & U_SC)
+                {
+                    const size_t sc_mode    = (c->pPorts->pScMode != NULL) ? size_t(c->pPorts->pScMode->value()) : size_t(dspu::SCM_RMS);
+                    const dspu::sidechain_source_t source = decode_sidechain_source(sc_src, bStereoSplit, i);
+                    const dspu::sidechain_stereo_mode_t stereo_mode = ((nMode == CM_MS) && (!use_sidechain(*c))) ? dspu::SCSM_MIDSIDE : dspu::SCSM_STEREO;
+                    c->nScType      = decode_sidechain_type(c->pPorts->pScType->value());
+
+                    c->sSC.set_gain(c->pPorts->pScPreamp->value());
+                    c->sSC.set_mode(sc_mode);
+                    c->sSC.set_source(source);
+                    c->sSC.set_reactivity(c->pPorts->pScReactivity->value());
+                    c->sSC.set_stereo_mode(stereo_mode);
+
+                    c->pAux->sDSC.set_gain(c->pPorts->pScPreamp->value());
+                    c->pAux->sDSC.set_mode(sc_mode);
+                    c->pAux->sDSC.set_source(source);
+                    c->pAux->sDSC.set_reactivity(c->pPorts->pScReactivity->value());
+                    c->pAux->sDSC.set_stereo_mode(stereo_mode);
+                    ++nReconfigs;
+                }
+
+                if (update & U_SC_EQ)
+                {
+                    // Setup hi-pass filter for sidechain
+                    size_t hp_slope = size_t(c->pPorts->pScHpfMode->value()) * 2;
+                    fp.nType        = (hp_slope > 0) ? dspu::FLT_BT_BWC_HIPASS : dspu::FLT_NONE;
+                    fp.fFreq        = c->pPorts->pScHpfFreq->value();
+                    fp.fFreq2       = fp.fFreq;
+                    fp.fGain        = 1.0f;
+                    fp.nSlope       = hp_slope;
+                    fp.fQuality     = 0.0f;
+                    c->pAux->sSCEq.set_params(0, &fp);
+                    for (size_t j=0; j<channels; ++j)
+                        c->pAux->vDSCEq[j].set_params(0, &fp);
+
+                    // Setup low-pass filter for sidechain
+                    size_t lp_slope = size_t(c->pPorts->pScLpfMode->value()) * 2;
+                    fp.nType        = (lp_slope > 0) ? dspu::FLT_BT_BWC_LOPASS : dspu::FLT_NONE;
+                    fp.fFreq        = c->pPorts->pScLpfFreq->value();
+                    fp.fFreq2       = fp.fFreq;
+                    fp.fGain        = 1.0f;
+                    fp.nSlope       = lp_slope;
+                    fp.fQuality     = 0.0f;
+                    c->pAux->sSCEq.set_params(1, &fp);
+                    for (size_t j=0; j<channels; ++j)
+                        c->pAux->vDSCEq[j].set_params(1, &fp);
+                    ++nReconfigs;
+                }
+
+                // Update delay, it is applied together with the latency. The gain computed by
+                // the decimated detector lags the input, the input is delayed by the maximum lag
+                if (update & U_LOOKAHEAD)
+                {
+                    size_t delay    = dspu::millis_to_samples(fSampleRate, (c->pPorts->pScLookahead != NULL) ? c->pPorts->pScLookahead->value() : 0);
+                    if (bScDecim)
+                        delay          += SC_DECIM_LATENCY;
+                    c->nNewLookahead= lsp_min(delay, c->sDelay.max_delay());
+                    ++nReconfigs;
+                }
 
                 // Update compressor settings
-                float attack    = c->pAttackLvl->value();
-                float release   = c->pReleaseLvl->value() * attack;
-                dspu::compressor_mode_t mode = decode_mode(c->pMode->value());
-
-                c->sComp.set_threshold(attack, release);
-                c->sComp.set_timings(c->pAttackTime->value(), c->pReleaseTime->value());
-                c->sComp.set_hold(c->pHoldTime->value());
-                c->sComp.set_ratio(c->pRatio->value());
-                c->sComp.set_knee(c->pKnee->value());
-                c->sComp.set_boost_threshold((mode != dspu::CM_BOOSTING) ? c->pBThresh->value() : c->pBoost->value());
-                c->sComp.set_mode(mode);
-                if (c->pReleaseOut != NULL)
-                    c->pReleaseOut->set_value(release);
-                c->sGraph[G_GAIN].set_method((mode == dspu::CM_DOWNWARD) ? dspu::MM_ABS_MINIMUM : dspu::MM_ABS_MAXIMUM);
-
-                // Check modification flag
-                if (c->sComp.modified())
+                if (update & U_COMP)
+                {
+                    const float attack  = c->pPorts->pAttackLvl->value();
+                    const float release = c->pPorts->pReleaseLvl->value() * attack;
+                    const dspu::compressor_mode_t mode = decode_mode(c->pPorts->pMode->value());
+
+                    configure_compressor(c);
+                    if (c->pPorts->pReleaseOut != NULL)
+                        c->pPorts->pReleaseOut->set_value(release);
+                    c->fIdleLevel   = lsp_max(lsp_min(release, GAIN_AMP_M_72_DB), GAIN_AMP_M_120_DB);
+                    c->pAux->sGraph[G_GAIN].set_method((mode == dspu::CM_DOWNWARD) ? dspu::MM_ABS_MINIMUM : dspu::MM_ABS_MAXIMUM);
+                    c->pAux->sHistory[G_GAIN].set_minimum(mode == dspu::CM_DOWNWARD);
+
+                    // Check modification flag
+                    if (c->sComp.modified())
+                    {
+                        c->sComp.update_settings();
+                        gc_update           = true;
+                    }
+                    ++nReconfigs;
+                }
+
+                // Update gain computers. The exact mode takes only the envelope from the gain computer
+                // and evaluates the curve by the compressor, the lookup table is rebuilt only while it
+                // is used by the table and control rate modes.
+                if (gc_update)
                 {
-                    c->sComp.update_settings();
-                    c->nSync           |= S_CURVE;
+                    const size_t factor = c->pAux->sDecim.factor();
+                    c->sGainComp.update(&c->sComp, fSampleRate, nGainComp != meta::compressor_metadata::GC_EXACT);
+                    if (factor > 1)
+                        c->pAux->sDGain.update(&c->sComp, fSampleRate / factor, nGainComp != meta::compressor_metadata::GC_EXACT);
                 }
 
-                // Update gains
-                float makeup            = c->pMakeup->value();
-                const float dry_gain    = c->pDryGain->value();
-                const float wet_gain    = c->pWetGain->value() * makeup;
-                const float drywet      = c->pDryWet->value() * 0.01f;
+                // All modes share the envelope follower of the gain computer, the control rate mode
+                // keeps own interpolated envelope. Continue from the current envelope to avoid jumps.
+                if (gc_reset)
+                {
+                    c->sGainComp.reset(c->fEnvLevel);
+                    c->pAux->sDGain.reset(c->fEnvLevel);
+                }
 
-                c->fDryGain         = (dry_gain * drywet + 1.0f - drywet) * out_gain;
-                c->fWetGain         = wet_gain * drywet * out_gain;
+                // Update control rate of the gain computer, the time constants are re-computed
+                // only when the step has changed. The decimated gain computer keeps the same
+                // step in time units.
+                const size_t decim_step = (nCtlStep > 0) ? lsp_max(nCtlStep / c->pAux->sDecim.factor(), size_t(1)) : 0;
+                c->sGainComp.set_step(nCtlStep);
+                c->pAux->sDGain.set_step(decim_step);
+                if (c->pPorts->pCtlError != NULL)
+                {
+                    const GainComputer *gc  = (c->pAux->sDecim.factor() > 1) ? &c->pAux->sDGain : &c->sGainComp;
+                    c->pPorts->pCtlError->set_value((nGainComp == meta::compressor_metadata::GC_CONTROL) ?
+                        100.0f * gc->control_error() : 0.0f);
+                }
 
-                if (c->fMakeup != makeup)
+                // Update gains
+                if (update & U_GAIN)
                 {
-                    c->fMakeup          = makeup;
-                    c->nSync           |= S_CURVE;
+                    float makeup            = c->pPorts->pMakeup->value();
+                    const float dry_gain    = c->pPorts->pDryGain->value();
+                    const float wet_gain    = c->pPorts->pWetGain->value() * makeup;
+                    const float drywet      = c->pPorts->pDryWet->value() * 0.01f;
+
+                    c->fDryGain         = (dry_gain * drywet + 1.0f - drywet) * out_gain;
+                    c->fWetGain         = wet_gain * drywet * out_gain;
+
+                    c->pAux->fMakeup    = makeup;
+                    ++nReconfigs;
                 }
+
+                nUpdate        |= update;
             }
+            nReconfigTotal += nReconfigs;
 
-            // Tune compensation delays
+            // Tune compensation delays and select the processing routine
+            size_t feedback = 0;
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c    = &vChannels[i];
-                c->sInDelay.set_delay(latency);
-                c->sOutDelay.set_delay(latency - c->sLaDelay.get_delay());
-                c->sDryDelay.set_delay(latency);
+                if (c->nScType == SCT_FEED_BACK)
+                    feedback       |= (1 << i);
+            }
+
+            // Delay lines are not fed in the idle state and logically contain silence
+            if (bIdle)
+            {
+                for (size_t i=0; i<channels; ++i)
+                    vChannels[i].sDelay.clear();
+            }
+
+            pProcess        = select_process_func(feedback);
+
+            update_latency();
+            update_chunk_size();
+            update_curves();
+        }
+
+        void compressor::update_latency()
+        {
+            const size_t channels   = (nMode == CM_MONO) ? 1 : 2;
+
+            size_t latency  = 0;
+            bool changed    = false;
+            for (size_t i=0; i<channels; ++i)
+            {
+                const channel_t *c  = &vChannels[i];
+                latency         = lsp_max(latency, c->nNewLookahead);
+                changed        |= c->nNewLookahead != c->nLookahead;
+            }
+            changed        |= latency != nLatency;
+            nIdleLimit      = lsp_max(lsp_max(latency, nLatency), nOldLatency) + meta::compressor_metadata::FEEDBACK_BLOCK;
+            nIdleSamples    = lsp_min(nIdleSamples, nIdleLimit);
+
+            // Switching taps in the middle of the crossfade would cause a jump of the signal,
+            // new delays are applied after the crossfade completes. In the idle state all delay
+            // lines contain silence and the crossfade does not matter.
+            bDelaySync      = (changed) && (nFade > 0) && (!bIdle);
+            if ((!changed) || (bDelaySync))
+                return;
+
+            // Crossfade between previous and new delays to avoid clicks. Delay lines are not
+            // fed without latency and logically contain silence
+            const bool fed  = (nLatency > 0) || (nFade > 0);
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                c->nOldLookahead    = c->nLookahead;
+                c->nLookahead       = c->nNewLookahead;
+                if (!fed)
+                    c->sDelay.clear();
             }
 
+            nOldLatency     = nLatency;
+            nFade           = ((latency > 0) || (nLatency > 0)) ? nFadeLength : 0;
+            nLatency        = latency;
+
             // Report latency
             set_latency(latency);
         }
 
+        void compressor::update_chunk_size()
+        {
+            size_t mode     = nBlockMode;
+
+            // Small host blocks are processed at once, large blocks are typical for offline rendering
+            if (mode == meta::compressor_metadata::BM_AUTO)
+            {
+                if (nHostBlock <= meta::compressor_metadata::BLOCK_LOW_LATENCY)
+                    mode            = meta::compressor_metadata::BM_LOW_LATENCY;
+                else if (nHostBlock >= meta::compressor_metadata::BLOCK_THROUGHPUT)
+                    mode            = meta::compressor_metadata::BM_THROUGHPUT;
+                else
+                    mode            = meta::compressor_metadata::BM_BALANCED;
+            }
+
+            switch (mode)
+            {
+                case meta::compressor_metadata::BM_LOW_LATENCY:
+                    nChunkSize      = meta::compressor_metadata::BLOCK_LOW_LATENCY;
+                    break;
+                case meta::compressor_metadata::BM_THROUGHPUT:
+                    nChunkSize      = meta::compressor_metadata::BLOCK_THROUGHPUT;
+                    break;
+                default:
+                    nChunkSize      = meta::compressor_metadata::BLOCK_BALANCED;
+                    break;
+            }
+        }
+
         void compressor::ui_activated()
         {
             size_t channels     = (nMode == CM_MONO) ? 1 : 2;
             for (size_t i=0; i<channels; ++i)
-                vChannels[i].nSync     = S_CURVE;
+            {
+                channel_t *c        = &vChannels[i];
+                c->pAux->nSync      = S_CURVE;
+
+            #ifndef LSP_PLUGINS_COMPRESSOR_HEADLESS
+                // Graphs were not updated while metering was off, drop the outdated history
+                if (!bMetering)
+                {
+                    for (size_t j=0; j<G_TOTAL; ++j)
+                    {
+                        c->pAux->sGraph[j].clear();
+                        c->pAux->sHistory[j].clear(history_default(j));
+                    }
+                }
+            #endif /* LSP_PLUGINS_COMPRESSOR_HEADLESS */
+            }
             bUISync             = true;
+            bMetering           = true;
+        }
+
+        void compressor::ui_deactivated()
+        {
+            bMetering           = false;
+        }
+
+        inline bool compressor::metering() const
+        {
+        #ifdef LSP_PLUGINS_COMPRESSOR_HEADLESS
+            return false;
+        #else
+            return bMetering;
+        #endif /* LSP_PLUGINS_COMPRESSOR_HEADLESS */
         }
 
         float compressor::process_feedback(channel_t *c, size_t i, size_t channels)
@@ -742,20 +1220,252 @@ namespace lsp
             // Process sidechain
             float scin      = c->sSC.process(in);
 
-            // Perform compression routine
-            c->vGain[i]     = c->sComp.process(&c->vEnv[i], scin);
+            // Perform compression routine, the control rate is not applicable for per-sample feed-back
+            if (nGainComp != meta::compressor_metadata::GC_EXACT)
+                c->vGain[i]     = c->sGainComp.process(&c->vEnv[i], scin);
+            else
+            {
+                c->vEnv[i]      = c->sGainComp.process_envelope(scin);
+                c->vGain[i]     = c->sComp.reduction(c->vEnv[i]);
+            }
             c->vOut[i]      = c->vGain[i] * c->vIn[i];
 
             return scin;
         }
 
+        void compressor::process_feedback_block(size_t mask, size_t channels, bool linked, size_t samples)
+        {
+            // The sidechain of the feed-back channel is fed by the output delayed by FEEDBACK_BLOCK
+            // samples instead of one sample. This allows to use block routines of the sidechain and
+            // compressor for each sub-block. Since the compressor's envelope can not change faster
+            // than allowed by the attack/release time constants, the difference of the envelope from
+            // the exact per-sample loop is limited by the change of the envelope within FEEDBACK_BLOCK
+            // samples, and the additional loop delay is FEEDBACK_BLOCK/sample_rate seconds (0.33 ms
+            // at 48 kHz). The bound is verified by the 'plugins.compressor' unit test.
+            constexpr size_t block_size = meta::compressor_metadata::FEEDBACK_BLOCK;
+            float *in[2];
+
+            for (size_t offset=0; offset < samples; )
+            {
+                const size_t to_do  = lsp_min(samples - offset, block_size);
+                in[0]               = vChannels[0].vFbHistory;
+                in[1]               = (channels > 1) ? vChannels[1].vFbHistory : NULL;
+
+                for (size_t i=0; i<channels; ++i)
+                {
+                    if (!(mask & (1 << i)))
+                        continue;
+
+                    channel_t *c        = &vChannels[i];
+                    c->sSC.process(&c->vSc[offset], const_cast<const float **>(in), to_do);
+                    compute_gain(c, &c->vGain[offset], &c->vEnv[offset], &c->vSc[offset], to_do);
+                    dsp::mul3(&c->vOut[offset], &c->vGain[offset], &c->vIn[offset], to_do);
+                }
+                if (linked)
+                    apply_linked_gain(offset, to_do);
+
+                for (size_t i=0; i<channels; ++i)
+                    update_feedback_history(&vChannels[i], &vChannels[i].vOut[offset], to_do);
+
+                offset             += to_do;
+            }
+
+            for (size_t i=0; i<channels; ++i)
+                vChannels[i].fFeedback  = vChannels[i].vOut[samples-1];
+        }
+
+        void compressor::apply_linked_gain(size_t offset, size_t samples)
+        {
+            // Sidechain, envelope and gain buffers of the second channel refer to the first channel
+            channel_t *c        = &vChannels[1];
+            dsp::mul3(&c->vOut[offset], &c->vGain[offset], &c->vIn[offset], samples);
+        }
+
+        void compressor::link_channels(bool linked)
+        {
+            // Linked channels share the detector: the second channel refers to the buffers of the first one
+            const channel_t *sc = &vChannels[0];
+            channel_t *c        = &vChannels[1];
+
+            c->vSc              = (linked) ? sc->vSc : c->pAux->vScBuf;
+            c->vEnv             = (linked) ? sc->vEnv : c->pAux->vEnvBuf;
+            c->vGain            = (linked) ? sc->vGain : c->pAux->vGainBuf;
+        }
+
+        void compressor::configure_compressor(channel_t *c)
+        {
+            const float attack  = c->pPorts->pAttackLvl->value();
+            const float release = c->pPorts->pReleaseLvl->value() * attack;
+            const dspu::compressor_mode_t mode = decode_mode(c->pPorts->pMode->value());
+
+            c->sComp.set_threshold(attack, release);
+            c->sComp.set_timings(c->pPorts->pAttackTime->value(), c->pPorts->pReleaseTime->value());
+            c->sComp.set_hold(c->pPorts->pHoldTime->value());
+            c->sComp.set_ratio(c->pPorts->pRatio->value());
+            c->sComp.set_knee(c->pPorts->pKnee->value());
+            c->sComp.set_boost_threshold((mode != dspu::CM_BOOSTING) ? c->pPorts->pBThresh->value() : c->pPorts->pBoost->value());
+            c->sComp.set_mode(mode);
+        }
+
+        void compressor::reset_detector(channel_t *c)
+        {
+            const size_t channels   = (nMode == CM_MONO) ? 1 : 2;
+
+            c->sSC.clear();
+            c->pAux->sSCEq.reset();
+            c->sGainComp.clear();
+            c->pAux->sDecim.clear();
+            c->pAux->sDSC.clear();
+            for (size_t j=0; j<channels; ++j)
+                c->pAux->vDSCEq[j].reset();
+            c->pAux->sDGain.clear();
+
+            c->fEnvLevel        = 0.0f;
+            c->fGainLevel       = c->sComp.reduction(GAIN_AMP_M_120_DB);
+        }
+
+        void compressor::update_feedback_history(channel_t *c, const float *out, size_t samples)
+        {
+            constexpr size_t block_size = meta::compressor_metadata::FEEDBACK_BLOCK;
+            float *h                    = c->vFbHistory;
+
+            if (samples >= block_size)
+                dsp::copy(h, &out[samples - block_size], block_size);
+            else
+            {
+                dsp::move(h, &h[samples], block_size - samples);
+                dsp::copy(&h[block_size - samples], out, samples);
+            }
+        }
+
         void compressor::process_non_feedback(channel_t *c, float **in, size_t samples)
         {
+            if (c->pAux->sDecim.factor() > 1)
+            {
+                process_decimated(c, in, samples);
+                return;
+            }
+
             c->sSC.process(c->vSc, const_cast<const float **>(in), samples);
-            c->sComp.process(c->vGain, c->vEnv, c->vSc, samples);
+            compute_gain(c, c->vGain, c->vEnv, c->vSc, samples);
+            dsp::mul3(c->vOut, c->vGain, c->vIn, samples); // Adjust gain for input
+        }
+
+        void compressor::process_non_feedback_x2(float **in_a, float **in_b, size_t samples)
+        {
+            channel_t *a    = &vChannels[0];
+            channel_t *b    = &vChannels[1];
+
+            // Only the table gain computer runs the channels in lockstep. The default exact mode
+            // evaluates the curve by dspu::Compressor for each channel, the control rate and the
+            // decimated detectors update the envelope once per step. The sidechains keep running
+            // one after another: the state of dspu::Sidechain is internal.
+            if ((nGainComp != meta::compressor_metadata::GC_TABLE) || (a->pAux->sDecim.factor() > 1) || (b->pAux->sDecim.factor() > 1))
+            {
+                process_non_feedback(a, in_a, samples);
+                process_non_feedback(b, in_b, samples);
+                return;
+            }
+
+            a->sSC.process(a->vSc, const_cast<const float **>(in_a), samples);
+            b->sSC.process(b->vSc, const_cast<const float **>(in_b), samples);
+
+            GainComputer * const gc[2]  = { &a->sGainComp, &b->sGainComp };
+            float * const gain[2]       = { a->vGain, b->vGain };
+            float * const env[2]        = { a->vEnv, b->vEnv };
+            const float * const sc[2]   = { a->vSc, b->vSc };
+            GainComputer::process_x2(gc, gain, env, sc, samples);
+
+            dsp::mul3(a->vOut, a->vGain, a->vIn, samples); // Adjust gain for input
+            dsp::mul3(b->vOut, b->vGain, b->vIn, samples);
+        }
+
+        void compressor::process_decimated(channel_t *c, float **in, size_t samples)
+        {
+            // Run the sidechain and the gain computer at the reduced sample rate. The sidechain
+            // filters are applied by the decimator before decimation. The detector output follows
+            // the full-rate detector with the delay of 2*N-1 samples: N-1 samples of the
+            // band-limiting window and N samples of the interpolation. The delay is compensated
+            // by the lookahead delay line.
+            SidechainDecimator *d   = &c->pAux->sDecim;
+            const size_t points     = d->decimate(const_cast<const float * const *>(in), samples);
+            if (points > 0)
+            {
+                const float *dec_in[SidechainDecimator::CHANNELS_MAX] = { d->input(0), d->input(1) };
+                float *gain             = d->stream(DS_GAIN);
+                float *env              = d->stream(DS_ENV);
+                float *sc               = d->stream(DS_SC);
+                c->pAux->sDSC.process(sc, dec_in, points);
+
+                // The time constants of dspu::Compressor are computed for the full sample rate,
+                // the envelope is always followed by the decimated gain computer. The exact mode
+                // evaluates the curve by the compressor for each decimated sample.
+                switch (nGainComp)
+                {
+                    case meta::compressor_metadata::GC_TABLE:
+                        c->pAux->sDGain.process(gain, env, sc, points);
+                        break;
+                    case meta::compressor_metadata::GC_CONTROL:
+                        c->pAux->sDGain.process_control(gain, env, sc, points);
+                        break;
+                    default:
+                        c->pAux->sDGain.process_envelope(env, sc, points);
+                        c->sComp.reduction(gain, env, points);
+                        break;
+                }
+            }
+
+            d->interpolate(c->vSc, DS_SC, samples);
+            d->interpolate(c->vEnv, DS_ENV, samples);
+            d->interpolate(c->vGain, DS_GAIN, samples);
             dsp::mul3(c->vOut, c->vGain, c->vIn, samples); // Adjust gain for input
         }
 
+        size_t compressor::decimation_factor(const channel_t *c) const
+        {
+            const channel_ports_t *cp   = c->pPorts;
+            if (!bScDecim)
+                return 1;
+
+            // The feed-back detector runs at the full rate, the lag of the decimated detector
+            // would not be compensated there
+            if (decode_sidechain_type(cp->pScType->value()) == SCT_FEED_BACK)
+                return 1;
+
+            // Peak detector needs each sample, short reactivity does not smooth the aliasing
+            const size_t sc_mode    = (cp->pScMode != NULL) ? size_t(cp->pScMode->value()) : size_t(dspu::SCM_RMS);
+            if ((sc_mode == dspu::SCM_PEAK) || (cp->pScReactivity->value() < meta::compressor_metadata::SC_DECIM_REACTIVITY))
+                return 1;
+
+            // The sidechain should be band-limited by the low-pass filter at least one octave
+            // below the Nyquist frequency of the decimated signal
+            if (size_t(cp->pScLpfMode->value()) == 0)
+                return 1;
+            const float band        = cp->pScLpfFreq->value() * 4.0f;
+            size_t factor           = 1;
+            while ((factor < meta::compressor_metadata::SC_DECIM_MAX) && (fSampleRate >= band * float(factor * 2)))
+                factor                <<= 1;
+
+            return factor;
+        }
+
+        inline void compressor::compute_gain(channel_t *c, float *gain, float *env, const float *sc, size_t samples)
+        {
+            switch (nGainComp)
+            {
+                case meta::compressor_metadata::GC_TABLE:
+                    c->sGainComp.process(gain, env, sc, samples);
+                    break;
+                case meta::compressor_metadata::GC_CONTROL:
+                    c->sGainComp.process_control(gain, env, sc, samples);
+                    break;
+                default:
+                    c->sGainComp.process_envelope(env, sc, samples);
+                    c->sComp.reduction(gain, env, samples);
+                    break;
+            }
+        }
+
         inline bool compressor::use_sidechain(const channel_t & c)
         {
             switch (c.nScType)
@@ -781,6 +1491,7 @@ namespace lsp
             return in;
         }
 
+        template <bool SC>
         void compressor::premix_channel(uint32_t channel, float * & in, float * & out, float * & sc, float * & link, size_t count)
         {
             // Get pointers to buffers and advance position
@@ -801,151 +1512,160 @@ namespace lsp
             if (link_buf != NULL)
                 sPremix.vLink[channel]  = &link_buf[count];
 
-            // Perform transformation
-            if (bSidechain)
-            {
-                // (Sc, Link) -> In
-                if ((sc_buf != NULL) && (sPremix.fScToIn > GAIN_AMP_M_INF_DB))
-                {
-                    in                  = sPremix.vTmpIn[channel];
-                    dsp::fmadd_k4(in, in_buf, sc_buf, sPremix.fScToIn, count);
-
-                    if ((link_buf != NULL) && (sPremix.fLinkToIn > GAIN_AMP_M_INF_DB))
-                        dsp::fmadd_k3(in, link_buf, sPremix.fLinkToIn, count);
-                }
-                else if ((link_buf != NULL) && (sPremix.fLinkToIn > GAIN_AMP_M_INF_DB))
-                {
-                    in                  = sPremix.vTmpIn[channel];
-                    dsp::fmadd_k4(in, in_buf, link_buf, sPremix.fLinkToIn, count);
-                }
+            // Routes from the link are not active while the link is not connected
+            uint32_t routes         = sPremix.nRoutes;
+            if (routes == 0)
+                return;
+            if (link_buf == NULL)
+                routes                 &= ~uint32_t(PR_FROM_LINK);
 
-                // (In, Link) -> Sc
-                if (sPremix.fInToSc > GAIN_AMP_M_INF_DB)
-                {
-                    sc                  = sPremix.vTmpSc[channel];
-                    if (sc_buf != NULL)
-                        dsp::fmadd_k4(sc, sc_buf, in_buf, sPremix.fInToSc, count);
-                    else
-                        dsp::mul_k3(sc, in_buf, sPremix.fInToSc, count);
+            // (Sc, Link) -> In, each combination takes a single pass
+            const bool sc_to_in     = (SC) && (routes & PR_SC_TO_IN);
+            const bool link_to_in   = routes & PR_LINK_TO_IN;
+            if ((sc_to_in) && (link_to_in))
+            {
+                in                      = sPremix.vTmpIn[channel];
+                dsp::mix_copy3(in, in_buf, sc_buf, link_buf, 1.0f, sPremix.fScToIn, sPremix.fLinkToIn, count);
+            }
+            else if (sc_to_in)
+            {
+                in                      = sPremix.vTmpIn[channel];
+                dsp::mix_copy2(in, in_buf, sc_buf, 1.0f, sPremix.fScToIn, count);
+            }
+            else if (link_to_in)
+            {
+                in                      = sPremix.vTmpIn[channel];
+                dsp::mix_copy2(in, in_buf, link_buf, 1.0f, sPremix.fLinkToIn, count);
+            }
 
-                    if ((link_buf != NULL) && (sPremix.fLinkToSc > GAIN_AMP_M_INF_DB))
-                        dsp::fmadd_k3(sc, link_buf, sPremix.fLinkToSc, count);
-                }
-                else if ((link_buf != NULL) && (sPremix.fLinkToSc > GAIN_AMP_M_INF_DB))
-                {
-                    sc                  = sPremix.vTmpSc[channel];
-                    if (sc_buf != NULL)
-                        dsp::fmadd_k4(sc, sc_buf, link_buf, sPremix.fLinkToSc, count);
-                    else
-                        dsp::mul_k3(sc, link_buf, sPremix.fLinkToSc, count);
-                }
+            // (In, Link) -> Sc, (In, Sc) -> Link
+            if (!(routes & (PR_TO_SC | PR_TO_LINK)))
+                return;
 
-                // (In, Sc) -> Link
-                if (sPremix.fInToLink > GAIN_AMP_M_INF_DB)
-                {
-                    link                = sPremix.vTmpLink[channel];
-                    if (link_buf != NULL)
-                        dsp::fmadd_k4(link, link_buf, in_buf, sPremix.fInToLink, count);
-                    else
-                        dsp::mul_k3(link, in_buf, sPremix.fInToLink, count);
+            float * const sc_dst    = (routes & PR_TO_SC) ? sPremix.vTmpSc[channel] : NULL;
+            float * const link_dst  = (routes & PR_TO_LINK) ? sPremix.vTmpLink[channel] : NULL;
+            const float * sc_src    = (sc_buf != NULL) ? sc_buf : vEmptyBuffer;
+            const float * link_src  = (link_buf != NULL) ? link_buf : vEmptyBuffer;
 
-                    if ((sc_buf != NULL) && (sPremix.fScToLink > GAIN_AMP_M_INF_DB))
-                        dsp::fmadd_k3(link, sc_buf, sPremix.fScToLink, count);
-                }
-                else if ((sc_buf != NULL) && (sPremix.fScToLink > GAIN_AMP_M_INF_DB))
+            if (sc_dst != NULL)
+            {
+                if (routes & PR_IN_TO_SC)
                 {
-                    link                = sPremix.vTmpLink[channel];
-                    if (link_buf != NULL)
-                        dsp::fmadd_k4(link, link_buf, sc_buf, sPremix.fScToLink, count);
-                    else
-                        dsp::mul_k3(link, sc_buf, sPremix.fScToLink, count);
+                    dsp::fmadd_k4(sc_dst, sc_src, in_buf, sPremix.fInToSc, count);
+                    if (routes & PR_LINK_TO_SC)
+                        dsp::fmadd_k3(sc_dst, link_src, sPremix.fLinkToSc, count);
                 }
+                else
+                    dsp::fmadd_k4(sc_dst, sc_src, link_src, sPremix.fLinkToSc, count);
             }
-            else
+            if (link_dst != NULL)
             {
-                // Link -> (In, Sc)
-                if (link_buf != NULL)
-                {
-                    // Link -> In
-                    if (sPremix.fLinkToIn > GAIN_AMP_M_INF_DB)
-                    {
-                        in              = sPremix.vTmpIn[channel];
-                        dsp::fmadd_k4(in, in_buf, link_buf, sPremix.fLinkToIn, count);
-                    }
-                    // Link -> Sc
-                    if (sPremix.fLinkToSc > GAIN_AMP_M_INF_DB)
-                    {
-                        sc              = sPremix.vTmpSc[channel];
-                        if (sc_buf != NULL)
-                            dsp::fmadd_k4(sc, sc_buf, link_buf, sPremix.fLinkToSc, count);
-                        else
-                            dsp::mul_k3(sc, link_buf, sPremix.fLinkToSc, count);
-                    }
-                }
-
-                // In -> Link
-                if (sPremix.fInToLink > GAIN_AMP_M_INF_DB)
+                if (routes & PR_IN_TO_LINK)
                 {
-                    link            = sPremix.vTmpLink[channel];
-                    if (link_buf != NULL)
-                        dsp::fmadd_k4(link, link_buf, in_buf, sPremix.fInToLink, count);
-                    else
-                        dsp::mul_k3(link, in_buf, sPremix.fInToLink, count);
+                    dsp::fmadd_k4(link_dst, link_src, in_buf, sPremix.fInToLink, count);
+                    if (routes & PR_SC_TO_LINK)
+                        dsp::fmadd_k3(link_dst, sc_src, sPremix.fScToLink, count);
                 }
+                else
+                    dsp::fmadd_k4(link_dst, link_src, sc_src, sPremix.fScToLink, count);
             }
+
+            if (sc_dst != NULL)
+                sc                      = sc_dst;
+            if (link_dst != NULL)
+                link                    = link_dst;
         }
 
-        void compressor::process(size_t samples)
+        void compressor::convert_to_ms(float **in, size_t count)
         {
-            size_t channels = (nMode == CM_MONO) ? 1 : 2;
-            size_t feedback = 0;
+            // Input gain is folded into the L/R -> M/S conversion matrix
+            const float k           = 0.5f * fInGain;
+            dsp::mix_copy2(vChannels[0].vIn, in[0], in[1], k, k, count);
+            dsp::mix_copy2(vChannels[1].vIn, in[0], in[1], k, -k, count);
+        }
 
-            float *in_buf[2];   // Input buffer
-            float *out_buf[2];  // Output buffer
-            float *sc_buf[2];   // Sidechain source
-            float *shm_buf[2];  // Sidechain source
-            float *in[2];       // Buffet to pass to sidechain
+        template <size_t MODE>
+        void compressor::output_stage(float **in_buf, float **out_buf, size_t samples)
+        {
+            constexpr size_t channels = (MODE == CM_MONO) ? 1 : 2;
+            const bool meters   = metering();
+            // All channels switch the bypass at once. Without the bypass crossfade the output is
+            // the wet signal, it is formed straight in the output buffers.
+            const bool direct   = vChannels[0].pAux->sBypass.off();
 
-            // Prepare audio channels
+            // Mix dry/wet signal or copy sidechain signal, Mid/Side channels are metered before conversion
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
+                float *dst          = ((MODE != CM_MS) && (direct)) ? out_buf[i] : c->vOut;
+                if ((MODE != CM_MS) && (c->bScListen))
+                    dsp::copy(dst, c->vSc, samples);
+                else
+                    dsp::mix_copy2(dst, c->vOut, c->vDelayIn, c->fWetGain, c->fDryGain, samples);
 
-                // Initialize pointers
-                sPremix.vIn[i]      = c->pIn->buffer<float>();
-                sPremix.vOut[i]     = c->pOut->buffer<float>();
-                sPremix.vSc[i]      = (c->pSC != NULL) ? c->pSC->buffer<float>() : sPremix.vIn[i];
-                sPremix.vLink[i]    = NULL;
+                if (meters)
+                    c->pAux->sGraph[G_OUT].process(dst, samples);                                 // Output signal
+                c->pPorts->pMeter[M_OUT]->set_value(dsp::abs_max(dst, samples));
+            }
 
-                core::AudioBuffer *buf = (c->pShmIn != NULL) ? c->pShmIn->buffer<core::AudioBuffer>() : NULL;
-                if ((buf != NULL) && (buf->active()))
-                    sPremix.vLink[i]    = buf->buffer();
+            if (MODE == CM_MS)
+            {
+                channel_t *cm       = &vChannels[0];
+                channel_t *cs       = &vChannels[1];
+                float *l            = (direct) ? out_buf[0] : cm->vOut;
+                float *r            = (direct) ? out_buf[1] : cs->vOut;
+
+                if (!bMSListen)
+                    dsp::ms_to_lr(l, r, cm->vOut, cs->vOut, samples);
+                else if (direct)
+                {
+                    dsp::copy(l, cm->vOut, samples);
+                    dsp::copy(r, cs->vOut, samples);
+                }
+                if (cm->bScListen)
+                    dsp::copy(l, cm->vSc, samples);
+                if (cs->bScListen)
+                    dsp::copy(r, cs->vSc, samples);
+            }
 
-                // Analyze channel mode
-                if (c->nScType == SCT_FEED_BACK)
-                    feedback           |= (1 << i);
+            if (direct)
+                return;
+
+            // Apply bypass crossfade
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                c->pAux->sBypass.process(out_buf[i], c->vDelayDry, c->vOut, samples);
             }
+        }
+
+        template <size_t MODE, bool LINKED, bool SC, size_t FEEDBACK>
+        void compressor::process_audio(size_t samples)
+        {
+            constexpr size_t channels = (MODE == CM_MONO) ? 1 : 2;
+
+            float *in_buf[2];   // Input buffer
+            float *out_buf[2];  // Output buffer
+            float *sc_buf[2];   // Sidechain source
+            float *shm_buf[2];  // Sidechain source
+            float *in[2];       // Buffet to pass to sidechain
+            const bool meters   = metering();
 
-            // Perform compression
             size_t left = samples;
             while (left > 0)
             {
                 // Detemine number of samples to process
-                const size_t to_process     = (left > COMP_BUF_SIZE) ? COMP_BUF_SIZE : left;
+                const size_t to_process     = (left > nChunkSize) ? nChunkSize : left;
 
                 // Pre-mix channel data
                 for (size_t i=0; i<channels; ++i)
-                    premix_channel(i, in_buf[i], out_buf[i], sc_buf[i], shm_buf[i], to_process);
+                    premix_channel<SC>(i, in_buf[i], out_buf[i], sc_buf[i], shm_buf[i], to_process);
 
                 // Prepare audio channels
-                if (nMode == CM_MONO)
+                if (MODE == CM_MONO)
                     dsp::mul_k3(vChannels[0].vIn, in_buf[0], fInGain, to_process);
-                else if (nMode == CM_MS)
-                {
-                    dsp::lr_to_ms(vChannels[0].vIn, vChannels[1].vIn, in_buf[0], in_buf[1], to_process);
-                    dsp::mul_k2(vChannels[0].vIn, fInGain, to_process);
-                    dsp::mul_k2(vChannels[1].vIn, fInGain, to_process);
-                }
+                else if (MODE == CM_MS)
+                    convert_to_ms(in_buf, to_process);
                 else
                 {
                     dsp::mul_k3(vChannels[0].vIn, in_buf[0], fInGain, to_process);
@@ -956,179 +1676,509 @@ namespace lsp
                 for (size_t i=0; i<channels; ++i)
                 {
                     channel_t *c        = &vChannels[i];
-                    // Update input graph
-                    c->sGraph[G_IN].process(c->vIn, to_process);
-                    c->pMeter[M_IN]->set_value(dsp::abs_max(c->vIn, to_process));
+                    if (meters)
+                        c->pAux->sGraph[G_IN].process(c->vIn, to_process);                        // Input graph
+                    c->pPorts->pMeter[M_IN]->set_value(dsp::abs_max(c->vIn, to_process));
                 }
 
                 // Do compression
-                switch (feedback)
+                if ((FEEDBACK != 0) && (bFbBlock))
                 {
-                    case 0:
+                    // Process non-feedback channels first, they provide the output history for sidechain
+                    for (size_t i=0; i<channels; ++i)
                     {
-                        if (channels > 1) // Process second channel in stereo pair
+                        if (FEEDBACK & (1 << i))
+                            continue;
+
+                        channel_t *c    = &vChannels[i];
+                        in[0]           = select_buffer(*c, vChannels[0].vIn, sc_buf[0], shm_buf[0]);
+                        in[1]           = (channels > 1) ? select_buffer(*c, vChannels[1].vIn, sc_buf[1], shm_buf[1]) : NULL;
+                        process_non_feedback(c, in, to_process);
+                    }
+
+                    process_feedback_block((LINKED) ? 0x1 : FEEDBACK, channels, LINKED, to_process);
+                }
+                else
+                {
+                    switch (FEEDBACK)
+                    {
+                        case 0:
                         {
-                            // First channel
-                            in[0]   = select_buffer(vChannels[0], vChannels[0].vIn, sc_buf[0], shm_buf[0]);
-                            in[1]   = select_buffer(vChannels[0], vChannels[1].vIn, sc_buf[1], shm_buf[1]);
-                            process_non_feedback(&vChannels[0], in, to_process);
-                            vChannels[0].fFeedback      = vChannels[0].vOut[to_process-1];
+                            if (LINKED)
+                            {
+                                // Both channels share the same detector: compute it once
+                                in[0]   = select_buffer(vChannels[0], vChannels[0].vIn, sc_buf[0], shm_buf[0]);
+                                in[1]   = select_buffer(vChannels[0], vChannels[1].vIn, sc_buf[1], shm_buf[1]);
+                                process_non_feedback(&vChannels[0], in, to_process);
+                                apply_linked_gain(0, to_process);
+                                vChannels[0].fFeedback      = vChannels[0].vOut[to_process-1];
+                                vChannels[1].fFeedback      = vChannels[1].vOut[to_process-1];
+                            }
+                            else if (channels > 1) // Process both channels of stereo pair in lockstep
+                            {
+                                float *in_b[2];
+                                in[0]   = select_buffer(vChannels[0], vChannels[0].vIn, sc_buf[0], shm_buf[0]);
+                                in[1]   = select_buffer(vChannels[0], vChannels[1].vIn, sc_buf[1], shm_buf[1]);
+                                in_b[0] = select_buffer(vChannels[1], vChannels[0].vIn, sc_buf[0], shm_buf[0]);
+                                in_b[1] = select_buffer(vChannels[1], vChannels[1].vIn, sc_buf[1], shm_buf[1]);
+                                process_non_feedback_x2(in, in_b, to_process);
+                                vChannels[0].fFeedback      = vChannels[0].vOut[to_process-1];
+                                vChannels[1].fFeedback      = vChannels[1].vOut[to_process-1];
+                            }
+                            else
+                            {
+                                // Only one channel
+                                in[0]   = select_buffer(vChannels[0], vChannels[0].vIn, sc_buf[0], shm_buf[0]);
+                                in[1]   = NULL;
+                                process_non_feedback(&vChannels[0], in, to_process);
+                                vChannels[0].fFeedback      = vChannels[0].vOut[to_process-1];
+                            }
 
-                            // Second channel
-                            in[0]   = select_buffer(vChannels[1], vChannels[0].vIn, sc_buf[0], shm_buf[0]);
-                            in[1]   = select_buffer(vChannels[1], vChannels[1].vIn, sc_buf[1], shm_buf[1]);
-                            process_non_feedback(&vChannels[1], in, to_process);
-                            vChannels[1].fFeedback      = vChannels[1].vOut[to_process-1];
+                            break;
                         }
-                        else
+
+                        case 1:
                         {
-                            // Only one channel
-                            in[0]   = select_buffer(vChannels[0], vChannels[0].vIn, sc_buf[0], shm_buf[0]);
-                            in[1]   = NULL;
-                            process_non_feedback(&vChannels[0], in, to_process);
-                            vChannels[0].fFeedback      = vChannels[0].vOut[to_process-1];
-                        }
+                            // 0=FB [1=FF/EXT]
+                            if (channels > 1)
+                            {
+                                // Second channel
+                                in[0]   = select_buffer(vChannels[1], vChannels[0].vIn, sc_buf[0], shm_buf[0]);
+                                in[1]   = select_buffer(vChannels[1], vChannels[1].vIn, sc_buf[1], shm_buf[1]);
+                                process_non_feedback(&vChannels[1], in, to_process);
+
+                                // Process feedback channel
+                                for (size_t i=0; i<to_process; ++i)
+                                {
+                                    vChannels[0].vSc[i]     = process_feedback(&vChannels[0], i, channels);
+                                    vChannels[0].fFeedback  = vChannels[0].vOut[i];
+                                    vChannels[1].fFeedback  = vChannels[1].vOut[i];
+                                }
+                            }
+                            else
+                            {
+                                // Process feedback channel
+                                for (size_t i=0; i<to_process; ++i)
+                                {
+                                    vChannels[0].vSc[i]     = process_feedback(&vChannels[0], i, channels);
+                                    vChannels[0].fFeedback  = vChannels[0].vOut[i];
+                                }
+                            }
 
-                        break;
-                    }
+                            break;
+                        }
 
-                    case 1:
-                    {
-                        // 0=FB [1=FF/EXT]
-                        if (channels > 1)
+                        case 2:
                         {
-                            // Second channel
-                            in[0]   = select_buffer(vChannels[1], vChannels[0].vIn, sc_buf[0], shm_buf[0]);
-                            in[1]   = select_buffer(vChannels[1], vChannels[1].vIn, sc_buf[1], shm_buf[1]);
-                            process_non_feedback(&vChannels[1], in, to_process);
+                            // 0=FF/EXT 1=FB
+                            // First channel
+                            in[0]   = select_buffer(vChannels[0], vChannels[0].vIn, sc_buf[0], shm_buf[0]);
+                            in[1]   = select_buffer(vChannels[0], vChannels[1].vIn, sc_buf[1], shm_buf[1]);
+                            process_non_feedback(&vChannels[0], in, to_process);
 
                             // Process feedback channel
                             for (size_t i=0; i<to_process; ++i)
                             {
-                                vChannels[0].vSc[i]     = process_feedback(&vChannels[0], i, channels);
-                                vChannels[0].fFeedback  = vChannels[0].vOut[i];
+                                vChannels[1].vSc[i]     = process_feedback(&vChannels[1], i, channels);
                                 vChannels[1].fFeedback  = vChannels[1].vOut[i];
+                                vChannels[0].fFeedback  = vChannels[0].vOut[i];
                             }
+
+                            break;
                         }
-                        else
+
+                        case 3:
                         {
-                            // Process feedback channel
-                            for (size_t i=0; i<to_process; ++i)
+                            // 0=FB, 1=FB
+                            if (LINKED)
                             {
-                                vChannels[0].vSc[i]     = process_feedback(&vChannels[0], i, channels);
-                                vChannels[0].fFeedback  = vChannels[0].vOut[i];
+                                // Both channels share the same detector: compute it once
+                                channel_t *cl           = &vChannels[0];
+                                channel_t *cr           = &vChannels[1];
+
+                                for (size_t i=0; i<to_process; ++i)
+                                {
+                                    cl->vSc[i]              = process_feedback(cl, i, channels);
+                                    cr->vOut[i]             = cr->vGain[i] * cr->vIn[i];
+                                    cl->fFeedback           = cl->vOut[i];
+                                    cr->fFeedback           = cr->vOut[i];
+                                }
+                            }
+                            else
+                            {
+                                for (size_t i=0; i<to_process; ++i)
+                                {
+                                    vChannels[0].vSc[i]     = process_feedback(&vChannels[0], i, channels);
+                                    vChannels[1].vSc[i]     = process_feedback(&vChannels[1], i, channels);
+                                    vChannels[0].fFeedback  = vChannels[0].vOut[i];
+                                    vChannels[1].fFeedback  = vChannels[1].vOut[i];
+                                }
                             }
+                            break;
                         }
-
-                        break;
+                        default:
+                            break;
                     }
+                }
 
-                    case 2:
-                    {
-                        // 0=FF/EXT 1=FB
-                        // First channel
-                        in[0]   = select_buffer(vChannels[0], vChannels[0].vIn, sc_buf[0], shm_buf[0]);
-                        in[1]   = select_buffer(vChannels[0], vChannels[1].vIn, sc_buf[1], shm_buf[1]);
-                        process_non_feedback(&vChannels[0], in, to_process);
-
-                        // Process feedback channel
-                        for (size_t i=0; i<to_process; ++i)
-                        {
-                            vChannels[1].vSc[i]     = process_feedback(&vChannels[1], i, channels);
-                            vChannels[1].fFeedback  = vChannels[1].vOut[i];
-                            vChannels[0].fFeedback  = vChannels[0].vOut[i];
-                        }
+                // Apply gain to each channel, compensate latency and process meters
+                for (size_t i=0; i<channels; ++i)
+                {
+                    channel_t *c        = &vChannels[i];
 
-                        break;
-                    }
+                    // Remember the state of the compressor for the idle mode
+                    c->fEnvLevel        = c->vEnv[to_process - 1];
+                    c->fGainLevel       = c->vGain[to_process - 1];
 
-                    case 3:
+                    // Process graph outputs
+                    if (meters)
                     {
-                        // 0=FB, 1=FB
-                        for (size_t i=0; i<to_process; ++i)
-                        {
-                            vChannels[0].vSc[i]     = process_feedback(&vChannels[0], i, channels);
-                            vChannels[1].vSc[i]     = process_feedback(&vChannels[1], i, channels);
-                            vChannels[0].fFeedback  = vChannels[0].vOut[i];
-                            vChannels[1].fFeedback  = vChannels[1].vOut[i];
-                        }
-                        break;
+                        c->pAux->sGraph[G_SC].process(c->vSc, to_process);                        // Sidechain signal
+                        c->pAux->sGraph[G_GAIN].process(c->vGain, to_process);                    // Gain reduction signal
+                        c->pAux->sGraph[G_ENV].process(c->vEnv, to_process);                      // Envelope signal
                     }
-                    default:
-                        break;
+                    c->pPorts->pMeter[M_SC]->set_value(dsp::abs_max(c->vSc, to_process));
+                    c->pPorts->pMeter[M_GAIN]->set_value(dsp::abs_max(c->vGain, to_process));
+                    c->pPorts->pMeter[M_ENV]->set_value(dsp::abs_max(c->vEnv, to_process));
                 }
 
-                // Apply gain to each channel, compensate latency and process meters
+                // Add delay to original signal and apply gain
+                compensate_latency(in_buf, to_process);
+
+                // Form output signal
+                output_stage<MODE>(in_buf, out_buf, to_process);
+
+                left       -= to_process;
+            }
+        }
+
+        void compressor::compensate_latency(float **dry, size_t samples)
+        {
+            const size_t channels   = (nMode == CM_MONO) ? 1 : 2;
+
+            // Without latency the output already contains the input multiplied by gain
+            if ((nLatency == 0) && (nFade == 0))
+            {
                 for (size_t i=0; i<channels; ++i)
                 {
                     channel_t *c        = &vChannels[i];
+                    c->vDelayIn         = c->vIn;
+                    c->vDelayDry        = dry[i];
+                }
+                return;
+            }
+
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
 
-                    // Add delay to original signal and apply gain
-                    c->sLaDelay.process(c->vOut, c->vIn, c->vGain, to_process);
-                    c->sInDelay.process(c->vIn, c->vIn, to_process);
-                    c->sOutDelay.process(c->vOut, c->vOut, to_process);
+                c->sDelay.append(DL_IN, c->vIn, samples);
+                c->sDelay.append(DL_GAIN, c->vGain, samples);
+                c->sDelay.append(DL_DRY, dry[i], samples);
 
-                    // Process graph outputs
-                    c->sGraph[G_SC].process(c->vSc, to_process);                        // Sidechain signal
-                    c->pMeter[M_SC]->set_value(dsp::abs_max(c->vSc, to_process));
+                // The gain is computed ahead of the input by the lookahead time. The part of the lookahead
+                // reserved for the decimated detector and not used by the current factor delays the gain
+                const float *in     = c->sDelay.tap(DL_IN, nLatency);
+                const float *gain   = c->sDelay.tap(DL_GAIN, nLatency - c->nLookahead + lsp_min(c->nScPad, c->nLookahead));
+                const float *xdry   = c->sDelay.tap(DL_DRY, nLatency);
 
-                    c->sGraph[G_GAIN].process(c->vGain, to_process);                    // Gain reduction signal
-                    c->pMeter[M_GAIN]->set_value(dsp::abs_max(c->vGain, to_process));
+                if (nFade > 0)
+                {
+                    // Crossfade signals delayed by previous and current latency
+                    const float *o_in   = c->sDelay.tap(DL_IN, nOldLatency);
+                    const float *o_gain = c->sDelay.tap(DL_GAIN, nOldLatency - c->nOldLookahead + lsp_min(c->nScPad, c->nOldLookahead));
+                    const float *o_dry  = c->sDelay.tap(DL_DRY, nOldLatency);
+                    const float delta   = 1.0f / nFadeLength;
+                    const size_t fade   = lsp_min(nFade, samples);
+
+                    for (size_t j=0; j<fade; ++j)
+                    {
+                        const float k       = (nFade - j) * delta;
+                        const float out     = in[j] * gain[j];
+                        c->vIn[j]           = in[j] + (o_in[j] - in[j]) * k;
+                        c->vOut[j]          = out + (o_in[j] * o_gain[j] - out) * k;
+                        c->vDry[j]          = xdry[j] + (o_dry[j] - xdry[j]) * k;
+                    }
+                    dsp::copy(&c->vIn[fade], &in[fade], samples - fade);
+                    dsp::mul3(&c->vOut[fade], &in[fade], &gain[fade], samples - fade);
+                    dsp::copy(&c->vDry[fade], &xdry[fade], samples - fade);
 
-                    c->sGraph[G_ENV].process(c->vEnv, to_process);                      // Envelope signal
-                    c->pMeter[M_ENV]->set_value(dsp::abs_max(c->vEnv, to_process));
+                    c->vDelayIn         = c->vIn;
+                    c->vDelayDry        = c->vDry;
+                }
+                else
+                {
+                    dsp::mul3(c->vOut, in, gain, samples);
+                    c->vDelayIn         = in;
+                    c->vDelayDry        = xdry;
                 }
 
-                // Form output signal
+                c->sDelay.advance(samples);
+            }
+
+            nFade          -= lsp_min(nFade, samples);
+        }
+
+        bool compressor::check_idle(size_t samples)
+        {
+            const size_t channels   = (nMode == CM_MONO) ? 1 : 2;
+
+            // Check that the envelope has decayed, the input does not need to be analyzed otherwise
+            for (size_t i=0; i<channels; ++i)
+            {
+                const channel_t *c      = &vChannels[i];
+                if (c->fEnvLevel >= c->fIdleLevel)
+                {
+                    nIdleSamples            = 0;
+                    return bIdle = false;
+                }
+            }
+
+            // Check that all inputs contain digital silence
+            for (size_t i=0; i<channels; ++i)
+            {
+                const float *in         = sPremix.vIn[i];
+                if ((dsp::abs_max(in, samples) > 0.0f) ||
+                    ((sPremix.vSc[i] != in) && (dsp::abs_max(sPremix.vSc[i], samples) > 0.0f)) ||
+                    ((sPremix.vLink[i] != NULL) && (dsp::abs_max(sPremix.vLink[i], samples) > 0.0f)))
+                {
+                    nIdleSamples            = 0;
+                    return bIdle = false;
+                }
+            }
+
+            // The block can be skipped only if all delay lines and the feed-back history
+            // already have been filled with silence
+            const bool idle = nIdleSamples >= nIdleLimit;
+            nIdleSamples    = lsp_min(nIdleSamples + samples, nIdleLimit);
+
+            // The envelope is still up to the idle level, bring detectors to the state they would
+            // reach on silence, so the signal after the idle period is processed the same way
+            if ((idle) && (!bIdle))
+            {
+                for (size_t i=0; i<channels; ++i)
+                    reset_detector(&vChannels[i]);
+            }
+
+            return bIdle = idle;
+        }
+
+        void compressor::process_idle(size_t samples)
+        {
+            // The output of the compressor is silence, only bypass and meters need to be updated
+            const size_t channels   = (nMode == CM_MONO) ? 1 : 2;
+            const bool meters       = metering();
+
+            for (size_t offset=0; offset < samples; )
+            {
+                const size_t to_do      = lsp_min(samples - offset, nChunkSize);
+
+                for (size_t i=0; i<channels; ++i)
+                {
+                    channel_t *c            = &vChannels[i];
+                    c->pAux->sBypass.process(&sPremix.vOut[i][offset], vEmptyBuffer, vEmptyBuffer, to_do);
+
+                    if (meters)
+                    {
+                        dsp::fill(c->vGain, c->fGainLevel, to_do);
+                        c->pAux->sGraph[G_IN].process(vEmptyBuffer, to_do);
+                        c->pAux->sGraph[G_SC].process(vEmptyBuffer, to_do);
+                        c->pAux->sGraph[G_ENV].process(vEmptyBuffer, to_do);
+                        c->pAux->sGraph[G_GAIN].process(c->vGain, to_do);
+                        c->pAux->sGraph[G_OUT].process(vEmptyBuffer, to_do);
+                    }
+                }
+
+                offset             += to_do;
+            }
+
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c            = &vChannels[i];
+                c->pPorts->pMeter[M_IN]->set_value(0.0f);
+                c->pPorts->pMeter[M_SC]->set_value(0.0f);
+                c->pPorts->pMeter[M_GAIN]->set_value(c->fGainLevel);
+                c->pPorts->pMeter[M_ENV]->set_value(0.0f);
+                c->pPorts->pMeter[M_OUT]->set_value(0.0f);
+            }
+        }
+
+        void compressor::process_bypass(size_t samples)
+        {
+            // The crossfade has completed and the output is the delayed dry signal. Only
+            // the delay lines and meters are fed to keep the latency and to resume without artifacts.
+            const size_t channels   = (nMode == CM_MONO) ? 1 : 2;
+            const bool delays       = (nLatency > 0) || (nFade > 0);
+            const bool meters       = metering();
+
+            float *in_buf[2];   // Input buffer
+            float *out_buf[2];  // Output buffer
+            float *sc_buf[2];   // Sidechain source
+            float *shm_buf[2];  // Sidechain source
+
+            for (size_t offset=0; offset < samples; )
+            {
+                const size_t to_process = lsp_min(samples - offset, nChunkSize);
+
+                // Pre-mix channel data
+                for (size_t i=0; i<channels; ++i)
+                {
+                    if (bSidechain)
+                        premix_channel<true>(i, in_buf[i], out_buf[i], sc_buf[i], shm_buf[i], to_process);
+                    else
+                        premix_channel<false>(i, in_buf[i], out_buf[i], sc_buf[i], shm_buf[i], to_process);
+                }
+
+                // Prepare audio channels, they are needed for delays and meters
                 if (nMode == CM_MS)
+                    convert_to_ms(in_buf, to_process);
+                else
                 {
-                    channel_t *cm       = &vChannels[0];
-                    channel_t *cs       = &vChannels[1];
-
-                    dsp::mix2(cm->vOut, cm->vIn, cm->fWetGain, cm->fDryGain, to_process);
-                    dsp::mix2(cs->vOut, cs->vIn, cs->fWetGain, cs->fDryGain, to_process);
-
-                    cm->sGraph[G_OUT].process(cm->vOut, to_process);
-                    cm->pMeter[M_OUT]->set_value(dsp::abs_max(cm->vOut, to_process));
-                    cs->sGraph[G_OUT].process(cs->vOut, to_process);
-                    cs->pMeter[M_OUT]->set_value(dsp::abs_max(cs->vOut, to_process));
-
-                    if (!bMSListen)
-                        dsp::ms_to_lr(cm->vOut, cs->vOut, cm->vOut, cs->vOut, to_process);
-                    if (cm->bScListen)
-                        dsp::copy(cm->vOut, cm->vSc, to_process);
-                    if (cs->bScListen)
-                        dsp::copy(cs->vOut, cs->vSc, to_process);
+                    for (size_t i=0; i<channels; ++i)
+                        dsp::mul_k3(vChannels[i].vIn, in_buf[i], fInGain, to_process);
+                }
+
+                // Feed lookahead and compensation delays
+                if (delays)
+                {
+                    for (size_t i=0; i<channels; ++i)
+                        dsp::fill(vChannels[i].vGain, vChannels[i].fGainLevel, to_process);
+                    compensate_latency(in_buf, to_process);
+                    for (size_t i=0; i<channels; ++i)
+                        dsp::copy(out_buf[i], vChannels[i].vDelayDry, to_process);
                 }
                 else
                 {
+                    // Output dry signal
                     for (size_t i=0; i<channels; ++i)
-                    {
-                        // Mix dry/wet signal or copy sidechain signal
-                        channel_t *c        = &vChannels[i];
-                        if (c->bScListen)
-                            dsp::copy(c->vOut, c->vSc, to_process);
-                        else
-                            dsp::mix2(c->vOut, c->vIn, c->fWetGain, c->fDryGain, to_process);
-
-                        c->sGraph[G_OUT].process(c->vOut, to_process);                      // Output signal
-                        c->pMeter[M_OUT]->set_value(dsp::abs_max(c->vOut, to_process));
-                    }
+                        dsp::copy(out_buf[i], in_buf[i], to_process);
                 }
 
-                // Final metering
+                // The signal passes unchanged, the history graphs get the same number of points as in other modes
                 for (size_t i=0; i<channels; ++i)
                 {
-                    // Apply bypass
-                    channel_t *c        = &vChannels[i];
-                    c->sDryDelay.process(c->vIn, in_buf[i], to_process);
-                    c->sBypass.process(out_buf[i], c->vIn, vChannels[i].vOut, to_process);
+                    channel_t *c            = &vChannels[i];
+                    const float *out        = (delays) ? c->vDelayIn : c->vIn;
+
+                    if (meters)
+                    {
+                        dsp::fill(c->vEnv, GAIN_AMP_0_DB, to_process);
+                        c->pAux->sGraph[G_IN].process(c->vIn, to_process);
+                        c->pAux->sGraph[G_SC].process(vEmptyBuffer, to_process);
+                        c->pAux->sGraph[G_ENV].process(vEmptyBuffer, to_process);
+                        c->pAux->sGraph[G_GAIN].process(c->vEnv, to_process);
+                        c->pAux->sGraph[G_OUT].process(out, to_process);
+                    }
+
+                    c->pPorts->pMeter[M_IN]->set_value(dsp::abs_max(c->vIn, to_process));
+                    c->pPorts->pMeter[M_SC]->set_value(0.0f);
+                    c->pPorts->pMeter[M_GAIN]->set_value(GAIN_AMP_0_DB);
+                    c->pPorts->pMeter[M_ENV]->set_value(0.0f);
+                    c->pPorts->pMeter[M_OUT]->set_value(dsp::abs_max(out, to_process));
                 }
 
-                left       -= to_process;
+                offset             += to_process;
+            }
+
+            bIdle           = false;
+            nIdleSamples    = 0;
+        }
+
+        compressor::process_func_t compressor::select_process_func(size_t feedback) const
+        {
+            #define PROC(mode, linked, sc, fb) \
+                &compressor::process_audio<mode, linked, sc, fb>
+            #define PROC_SET(mode, linked) \
+                { \
+                    PROC(mode, linked, false, 0), PROC(mode, linked, false, 1), PROC(mode, linked, false, 2), PROC(mode, linked, false, 3), \
+                    PROC(mode, linked, true, 0), PROC(mode, linked, true, 1), PROC(mode, linked, true, 2), PROC(mode, linked, true, 3) \
+                }
+
+            static const process_func_t mono_funcs[] =
+            {
+                PROC(CM_MONO, false, false, 0), PROC(CM_MONO, false, false, 1),
+                PROC(CM_MONO, false, true, 0), PROC(CM_MONO, false, true, 1)
+            };
+            static const process_func_t stereo_funcs[][8] =
+            {
+                PROC_SET(CM_STEREO, false),
+                PROC_SET(CM_STEREO, true),
+                PROC_SET(CM_LR, false),
+                PROC_SET(CM_MS, false)
+            };
+
+            #undef PROC_SET
+            #undef PROC
+
+            const size_t sc     = (bSidechain) ? 1 : 0;
+
+            switch (nMode)
+            {
+                case CM_STEREO:
+                    // Without stereo split both channels share the same settings and sidechain
+                    // inputs, so the feed-back mask is either 0 or 3 and detector may be computed once
+                    return stereo_funcs[(bStereoSplit) ? 0 : 1][sc * 4 + (feedback & 0x3)];
+                case CM_LR:     return stereo_funcs[2][sc * 4 + (feedback & 0x3)];
+                case CM_MS:     return stereo_funcs[3][sc * 4 + (feedback & 0x3)];
+                default:        break;
             }
 
-            if ((!bPause) || (bClear) || (bUISync))
+            return mono_funcs[sc * 2 + (feedback & 0x1)];
+        }
+
+        void compressor::process(size_t samples)
+        {
+            const size_t channels = (nMode == CM_MONO) ? 1 : 2;
+
+            // Prepare audio channels
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                // Initialize pointers
+                sPremix.vIn[i]      = c->pPorts->pIn->buffer<float>();
+                sPremix.vOut[i]     = c->pPorts->pOut->buffer<float>();
+                sPremix.vSc[i]      = (c->pPorts->pSC != NULL) ? c->pPorts->pSC->buffer<float>() : sPremix.vIn[i];
+                sPremix.vLink[i]    = NULL;
+
+                core::AudioBuffer *buf = (c->pPorts->pShmIn != NULL) ? c->pPorts->pShmIn->buffer<core::AudioBuffer>() : NULL;
+                if ((buf != NULL) && (buf->active()))
+                    sPremix.vLink[i]    = buf->buffer();
+            }
+
+            // Adjust the processing chunk to the size of blocks passed by the host
+            if (samples > nHostBlock)
+            {
+                nHostBlock          = samples;
+                update_chunk_size();
+            }
+
+            // Apply delays changed during the previous crossfade
+            if ((bDelaySync) && ((nFade == 0) || (bIdle)))
+                update_latency();
+
+            // Perform compression
+            if (vChannels[0].pAux->sBypass.bypassing())
+                process_bypass(samples);
+            else if (check_idle(samples))
+                process_idle(samples);
+            else
+                (this->*pProcess)(samples);
+
+            // Count points appended to the history graphs since the last transfer
+            const bool meters   = metering();
+            if (meters)
+            {
+                nHistoryPhase      += samples;
+                const size_t points = lsp_min(nHistoryPhase / nHistoryPeriod, size_t(meta::compressor_metadata::TIME_MESH_SIZE));
+                nHistoryPoints      = lsp_min(nHistoryPoints + points, size_t(meta::compressor_metadata::TIME_MESH_SIZE));
+                nHistoryPhase      %= nHistoryPeriod;
+                if (points > 0)
+                    update_history(points);
+            }
+
+            // The history meshes are transferred only when the graphs have got new points
+            if ((meters) && (((!bPause) && (nHistoryPoints > 0)) || (bClear) || (bUISync)))
             {
                 // Process mesh requests
                 for (size_t i=0; i<channels; ++i)
@@ -1139,15 +2189,18 @@ namespace lsp
                     for (size_t j=0; j<G_TOTAL; ++j)
                     {
                         // Check that port is bound
-                        if (c->pGraph[j] == NULL)
+                        if (c->pPorts->pGraph[j] == NULL)
                             continue;
 
                         // Clear data if requested
                         if (bClear)
-                            c->sGraph[j].clear();
+                        {
+                            c->pAux->sGraph[j].clear();
+                            c->pAux->sHistory[j].clear(history_default(j));
+                        }
 
                         // Get mesh
-                        plug::mesh_t *mesh    = c->pGraph[j]->buffer<plug::mesh_t>();
+                        plug::mesh_t *mesh    = c->pPorts->pGraph[j]->buffer<plug::mesh_t>();
                         if ((mesh != NULL) && (mesh->isEmpty()))
                         {
                             // Fill mesh with new values
@@ -1156,8 +2209,7 @@ namespace lsp
                                 float *x = mesh->pvData[0];
                                 float *y = mesh->pvData[1];
 
-                                dsp::copy(&x[1], vTime, meta::compressor_metadata::TIME_MESH_SIZE);
-                                c->sGraph[j].read(&y[1], meta::compressor_metadata::TIME_MESH_SIZE);
+                                read_history(c, j, &x[1], &y[1]);
 
                                 x[0] = x[1];
                                 y[0] = 0.0f;
@@ -1174,8 +2226,7 @@ namespace lsp
                                 float *x = mesh->pvData[0];
                                 float *y = mesh->pvData[1];
 
-                                dsp::copy(&x[2], vTime, meta::compressor_metadata::TIME_MESH_SIZE);
-                                c->sGraph[j].read(&y[2], meta::compressor_metadata::TIME_MESH_SIZE);
+                                read_history(c, j, &x[2], &y[2]);
 
                                 x[0] = x[2] + 0.5f;
                                 x[1] = x[0];
@@ -1193,15 +2244,15 @@ namespace lsp
                             }
                             else
                             {
-                                dsp::copy(mesh->pvData[0], vTime, meta::compressor_metadata::TIME_MESH_SIZE);
-                                c->sGraph[j].read(mesh->pvData[1], meta::compressor_metadata::TIME_MESH_SIZE);
+                                read_history(c, j, mesh->pvData[0], mesh->pvData[1]);
                                 mesh->data(2, meta::compressor_metadata::TIME_MESH_SIZE);
                             }
                         }
                     } // for j
                 }
 
-                bUISync     = false;
+                bUISync         = false;
+                nHistoryPoints  = 0;
             }
 
             // Output compressor curves for each channel
@@ -1210,32 +2261,199 @@ namespace lsp
                 channel_t *c       = &vChannels[i];
 
                 // Output compression curve
-                if (c->pCurve != NULL)
+                if ((meters) && (c->pPorts->pCurve != NULL))
                 {
-                    plug::mesh_t *mesh            = c->pCurve->buffer<plug::mesh_t>();
-                    if ((c->nSync & S_CURVE) && (mesh != NULL) && (mesh->isEmpty()))
+                    plug::mesh_t *mesh            = c->pPorts->pCurve->buffer<plug::mesh_t>();
+                    if ((c->pAux->nSync & S_CURVE) && (mesh != NULL) && (mesh->isEmpty()))
                     {
                         // Copy frequency points
                         dsp::copy(mesh->pvData[0], vCurve, meta::compressor_metadata::CURVE_MESH_SIZE);
-                        c->sComp.curve(mesh->pvData[1], vCurve, meta::compressor_metadata::CURVE_MESH_SIZE);
-                        if (c->fMakeup != 1.0f)
-                            dsp::mul_k2(mesh->pvData[1], c->fMakeup, meta::compressor_metadata::CURVE_MESH_SIZE);
+                        dsp::copy(mesh->pvData[1], c->pAux->pGainCurve, meta::compressor_metadata::CURVE_MESH_SIZE);
 
                         // Mark mesh containing data
                         mesh->data(2, meta::compressor_metadata::CURVE_MESH_SIZE);
-                        c->nSync &= ~S_CURVE;
+                        c->pAux->nSync &= ~S_CURVE;
                     }
                 }
 
                 // Update meter
-                if ((c->pMeter[M_ENV] != NULL) && (c->pMeter[M_CURVE] != NULL))
+                if ((c->pPorts->pMeter[M_ENV] != NULL) && (c->pPorts->pMeter[M_CURVE] != NULL))
                 {
-                    c->fDotIn   = c->pMeter[M_ENV]->value();
-                    c->fDotOut  = c->sComp.curve(c->fDotIn) * c->fMakeup;
-                    c->pMeter[M_CURVE]->set_value(c->fDotOut);
+                    c->pAux->fDotIn   = c->pPorts->pMeter[M_ENV]->value();
+                    c->pAux->fDotOut  = c->sComp.curve(c->pAux->fDotIn) * c->pAux->fMakeup;
+                    c->pPorts->pMeter[M_CURVE]->set_value(c->pAux->fDotOut);
                 }
             }
 
+            // Publish the state for the inline display after the metering
+            publish_display(samples);
+        }
+
+        inline float compressor::history_default(size_t graph)
+        {
+            return (graph == G_GAIN) ? GAIN_AMP_0_DB : GAIN_AMP_M_INF_DB;
+        }
+
+        void compressor::update_history(size_t points)
+        {
+            size_t channels     = (nMode == CM_MONO) ? 1 : 2;
+
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                // The envelope buffer is not used until the next block, take it as a temporary buffer
+                for (size_t j=0; j<G_TOTAL; ++j)
+                {
+                    c->pAux->sGraph[j].read(c->vEnv, points);
+                    c->pAux->sHistory[j].push(c->vEnv, points);
+                }
+            }
+        }
+
+        void compressor::read_history(channel_t *c, size_t graph, float *x, float *y)
+        {
+            if (nHistoryZoom == meta::compressor_metadata::HZ_5S)
+            {
+                dsp::copy(x, vTime, meta::compressor_metadata::TIME_MESH_SIZE);
+                c->pAux->sGraph[graph].read(y, meta::compressor_metadata::TIME_MESH_SIZE);
+                return;
+            }
+
+            // Take the zoomed out history from the pyramid
+            const size_t level  = lsp_min(nHistoryZoom, size_t(meta::compressor_metadata::HZ_TOTAL - 1)) - 1;
+            float scale         = 1.0f;
+            for (size_t i=0; i<=level; ++i)
+                scale              *= history_ratios[i];
+
+            dsp::mul_k3(x, vTime, scale, meta::compressor_metadata::TIME_MESH_SIZE);
+            c->pAux->sHistory[graph].read(level, y);
+        }
+
+        void compressor::make_curve_key(curve_key_t *key, const channel_ports_t *cp)
+        {
+            key->nMode          = uint32_t(cp->vParams[CP_MODE]);
+            key->fThreshold     = cp->vParams[CP_ATTACK_LVL];
+            key->fBThresh       = cp->vParams[CP_BTHRESH];
+            key->fBoost         = cp->vParams[CP_BOOST];
+            key->fRatio         = cp->vParams[CP_RATIO];
+            key->fKnee          = cp->vParams[CP_KNEE];
+            key->fMakeup        = cp->vParams[CP_MAKEUP];
+        }
+
+        inline bool compressor::same_curve(const curve_key_t & a, const curve_key_t & b)
+        {
+            return (a.nMode == b.nMode) &&
+                (a.fThreshold == b.fThreshold) &&
+                (a.fBThresh == b.fBThresh) &&
+                (a.fBoost == b.fBoost) &&
+                (a.fRatio == b.fRatio) &&
+                (a.fKnee == b.fKnee) &&
+                (a.fMakeup == b.fMakeup);
+        }
+
+        void compressor::update_curves()
+        {
+            size_t channels     = (nMode == CM_MONO) ? 1 : 2;
+            bool changed        = false;
+
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                curve_key_t key;
+                make_curve_key(&key, c->pPorts);
+
+                // Channels with the same curve settings share one curve
+                const float *curve  = NULL;
+                for (size_t j=0; j<i; ++j)
+                {
+                    if (same_curve(vChannels[j].pAux->sCurveKey, key))
+                    {
+                        curve               = vChannels[j].pAux->pGainCurve;
+                        break;
+                    }
+                }
+
+                // Evaluate the curve only if the settings have changed
+                if (curve == NULL)
+                {
+                    if ((c->pAux->pGainCurve != c->pAux->vGainCurve) || (!same_curve(c->pAux->sCurveKey, key)))
+                    {
+                        c->sComp.curve(c->pAux->vGainCurve, vCurve, meta::compressor_metadata::CURVE_MESH_SIZE);
+                        if (c->pAux->fMakeup != 1.0f)
+                            dsp::mul_k2(c->pAux->vGainCurve, c->pAux->fMakeup, meta::compressor_metadata::CURVE_MESH_SIZE);
+                        c->pAux->pGainCurve = NULL;
+                    }
+                    curve               = c->pAux->vGainCurve;
+                }
+
+                if ((c->pAux->pGainCurve == curve) && (same_curve(c->pAux->sCurveKey, key)))
+                    continue;
+
+                c->pAux->sCurveKey  = key;
+                c->pAux->pGainCurve = curve;
+                c->pAux->nSync           |= S_CURVE;
+                changed             = true;
+            }
+
+            if (changed)
+                ++nCurveVersion;
+        }
+
+        void compressor::publish_display(size_t samples)
+        {
+            // Do not publish the state more often than the display is able to draw it
+            if (nDisplayDelay > samples)
+            {
+                nDisplayDelay  -= samples;
+                return;
+            }
+            nDisplayDelay       = 0;
+
+            const display_t *last   = sDisplay.last();
+            display_t *d            = sDisplay.back();
+
+            d->nCurves      = ((nMode == CM_MONO) || (nMode == CM_STEREO)) ? 1 : 2;
+            d->nDots        = (active()) ?
+                              (((nMode == CM_MONO) || ((nMode == CM_STEREO) && (!bStereoSplit))) ? 1 : 2) : 0;
+            d->bBypass      = vChannels[0].pAux->sBypass.bypassing();
+            d->bActive      = active();
+            for (size_t i=0; i<d->nDots; ++i)
+            {
+                const channel_t *c  = &vChannels[i];
+                d->vDotIn[i]        = c->pAux->fDotIn;
+                d->vDotOut[i]       = c->pAux->fDotOut;
+            }
+
+            // The slot may hold curves of the older version
+            if (d->nCurveVersion != nCurveVersion)
+            {
+                for (size_t i=0; i<d->nCurves; ++i)
+                    dsp::copy(d->vCurve[i], vChannels[i].pAux->pGainCurve, meta::compressor_metadata::CURVE_MESH_SIZE);
+                d->nCurveVersion    = nCurveVersion;
+            }
+
+            // Do not publish and redraw the same state
+            if ((d->nCurveVersion == last->nCurveVersion) &&
+                (d->nCurves == last->nCurves) &&
+                (d->nDots == last->nDots) &&
+                (d->bBypass == last->bBypass) &&
+                (d->bActive == last->bActive))
+            {
+                size_t i = 0;
+                for ( ; i<d->nDots; ++i)
+                {
+                    if ((d->vDotIn[i] != last->vDotIn[i]) || (d->vDotOut[i] != last->vDotOut[i]))
+                        break;
+                }
+                if (i >= d->nDots)
+                    return;
+            }
+
+            d->nVersion     = last->nVersion + 1;
+            sDisplay.publish();
+            nDisplayDelay   = nDisplayPeriod;
+
             // Request for redraw
             if (pWrapper != NULL)
                 pWrapper->query_display_draw();
@@ -1253,52 +2471,74 @@ namespace lsp
             width   = cv->width();
             height  = cv->height();
 
+            // Render only the state published by the audio thread
+            const display_t *d  = sDisplay.front();
+
             // Clear background
-            bool bypassing = vChannels[0].sBypass.bypassing();
+            bool bypassing = d->bBypass;
             cv->set_color_rgb((bypassing) ? CV_DISABLED : CV_BACKGROUND);
             cv->paint();
 
-            float zx    = 1.0f/GAIN_AMP_M_72_DB;
-            float zy    = 1.0f/GAIN_AMP_M_72_DB;
-            float dx    = width/(logf(GAIN_AMP_P_24_DB)-logf(GAIN_AMP_M_72_DB));
-            float dy    = height/(logf(GAIN_AMP_M_72_DB)-logf(GAIN_AMP_P_24_DB));
+            // Recompute the cached geometry only when the canvas size has changed
+            display_cache_t *dc = &sIDCache;
+            const float zx      = 1.0f/GAIN_AMP_M_72_DB;
+            const float zy      = 1.0f/GAIN_AMP_M_72_DB;
+            if ((dc->nWidth != width) || (dc->nHeight != height))
+            {
+                dc->fDX             = width/(logf(GAIN_AMP_P_24_DB)-logf(GAIN_AMP_M_72_DB));
+                dc->fDY             = height/(logf(GAIN_AMP_M_72_DB)-logf(GAIN_AMP_P_24_DB));
+
+                dc->nLines          = 0;
+                for (float i=GAIN_AMP_M_72_DB; (i<GAIN_AMP_P_24_DB) && (dc->nLines < (sizeof(dc->vGridX)/sizeof(float))); i *= GAIN_AMP_P_24_DB)
+                {
+                    dc->vGridX[dc->nLines]  = dc->fDX*(logf(i*zx));
+                    dc->vGridY[dc->nLines]  = height + dc->fDY*(logf(i*zy));
+                    ++dc->nLines;
+                }
+
+                dc->vDiag[0]        = dc->fDX*(logf(GAIN_AMP_M_72_DB*zx));
+                dc->vDiag[1]        = height + dc->fDY*(logf(GAIN_AMP_M_72_DB*zy));
+                dc->vDiag[2]        = dc->fDX*(logf(GAIN_AMP_P_24_DB*zx));
+                dc->vDiag[3]        = height + dc->fDY*(logf(GAIN_AMP_P_24_DB*zy));
+                dc->vAxis[0]        = dc->fDX*(logf(GAIN_AMP_0_DB*zx));
+                dc->vAxis[1]        = height + dc->fDY*(logf(GAIN_AMP_0_DB*zy));
+
+                dc->nWidth          = width;
+                dc->nHeight         = height;
+                dc->nCurveVersion   = 0;
+            }
+
+            const float dx      = dc->fDX;
+            const float dy      = dc->fDY;
 
             // Draw horizontal and vertical lines
             cv->set_line_width(1.0);
             cv->set_color_rgb((bypassing) ? CV_SILVER: CV_YELLOW, 0.5f);
-            for (float i=GAIN_AMP_M_72_DB; i<GAIN_AMP_P_24_DB; i *= GAIN_AMP_P_24_DB)
+            for (size_t i=0; i<dc->nLines; ++i)
             {
-                float ax = dx*(logf(i*zx));
-                float ay = height + dy*(logf(i*zy));
-                cv->line(ax, 0, ax, height);
-                cv->line(0, ay, width, ay);
+                cv->line(dc->vGridX[i], 0, dc->vGridX[i], height);
+                cv->line(0, dc->vGridY[i], width, dc->vGridY[i]);
             }
 
             // Draw 1:1 line
             cv->set_line_width(2.0);
             cv->set_color_rgb(CV_GRAY);
-            {
-                float ax1 = dx*(logf(GAIN_AMP_M_72_DB*zx));
-                float ax2 = dx*(logf(GAIN_AMP_P_24_DB*zx));
-                float ay1 = height + dy*(logf(GAIN_AMP_M_72_DB*zy));
-                float ay2 = height + dy*(logf(GAIN_AMP_P_24_DB*zy));
-                cv->line(ax1, ay1, ax2, ay2);
-            }
+            cv->line(dc->vDiag[0], dc->vDiag[1], dc->vDiag[2], dc->vDiag[3]);
 
             // Draw axis
             cv->set_color_rgb((bypassing) ? CV_SILVER : CV_WHITE);
-            {
-                float ax = dx*(logf(GAIN_AMP_0_DB*zx));
-                float ay = height + dy*(logf(GAIN_AMP_0_DB*zy));
-                cv->line(ax, 0, ax, height);
-                cv->line(0, ay, width, ay);
-            }
+            cv->line(dc->vAxis[0], 0, dc->vAxis[0], height);
+            cv->line(0, dc->vAxis[1], width, dc->vAxis[1]);
 
-            // Reuse display
-            pIDisplay           = core::IDBuffer::reuse(pIDisplay, 4, width);
+            // Reuse display: coordinates of each curve followed by two temporary rows
+            core::IDBuffer *old = pIDisplay;
+            pIDisplay           = core::IDBuffer::reuse(pIDisplay, 6, width);
             core::IDBuffer *b   = pIDisplay;
             if (b == NULL)
+            {
+                dc->nCurveVersion   = 0;
                 return false;
+            }
 
             static const uint32_t c_colors[] =
             {
@@ -1306,57 +2546,63 @@ namespace lsp
                 CV_LEFT_CHANNEL, CV_RIGHT_CHANNEL,
                 CV_MIDDLE_CHANNEL, CV_SIDE_CHANNEL
             };
-            size_t curves       = ((nMode == CM_MONO) || (nMode == CM_STEREO)) ? 1 : 2;
+            size_t curves       = d->nCurves;
             const uint32_t *vc  = (curves == 1) ? &c_colors[0] :
                                   (nMode == CM_MS) ? &c_colors[3] :
                                   &c_colors[1];
 
+            // Recompute the curve polylines only when the curves or the buffer have changed
+            if ((b != old) || (dc->nCurveVersion != d->nCurveVersion))
+            {
+                for (size_t i=0; i<curves; ++i)
+                {
+                    const float *curve  = d->vCurve[i];
+                    float *x            = b->v[i*2];
+                    float *y            = b->v[i*2 + 1];
+
+                    for (size_t j=0; j<width; ++j)
+                    {
+                        size_t k        = (j*meta::compressor_metadata::CURVE_MESH_SIZE)/width;
+                        b->v[4][j]      = vCurve[k];
+                        b->v[5][j]      = curve[k];
+                    }
+
+                    dsp::fill(x, 0.0f, width);
+                    dsp::fill(y, height, width);
+                    dsp::axis_apply_log1(x, b->v[4], zx, dx, width);
+                    dsp::axis_apply_log1(y, b->v[5], zy, dy, width);
+                }
+                dc->nCurveVersion   = d->nCurveVersion;
+            }
+
             bool aa = cv->set_anti_aliasing(true);
             lsp_finally { cv->set_anti_aliasing(aa); };
             cv->set_line_width(2);
 
+            // Draw meshes
             for (size_t i=0; i<curves; ++i)
             {
-                channel_t *c    = &vChannels[i];
-
-                for (size_t j=0; j<width; ++j)
-                {
-                    size_t k        = (j*meta::compressor_metadata::CURVE_MESH_SIZE)/width;
-                    b->v[0][j]      = vCurve[k];
-                }
-                c->sComp.curve(b->v[1], b->v[0], width);
-                if (c->fMakeup != 1.0f)
-                    dsp::mul_k2(b->v[1], c->fMakeup, width);
-
-                dsp::fill(b->v[2], 0.0f, width);
-                dsp::fill(b->v[3], height, width);
-                dsp::axis_apply_log1(b->v[2], b->v[0], zx, dx, width);
-                dsp::axis_apply_log1(b->v[3], b->v[1], zy, dy, width);
-
-                // Draw mesh
-                uint32_t color  = (bypassing || !(active())) ? CV_SILVER : vc[i];
+                uint32_t color  = (bypassing || !(d->bActive)) ? CV_SILVER : vc[i];
                 cv->set_color_rgb(color);
-                cv->draw_lines(b->v[2], b->v[3], width);
+                cv->draw_lines(b->v[i*2], b->v[i*2 + 1], width);
             }
 
             // Draw dot
-            if (active())
+            if (d->nDots > 0)
             {
-                size_t channels     = ((nMode == CM_MONO) || ((nMode == CM_STEREO) && (!bStereoSplit))) ? 1 : 2;
+                size_t channels     = d->nDots;
                 const uint32_t *vd  = (channels == 1) ? &c_colors[0] :
                                       (nMode == CM_MS) ? &c_colors[3] :
                                       &c_colors[1];
 
                 for (size_t i=0; i<channels; ++i)
                 {
-                    channel_t *c    = &vChannels[i];
-
                     uint32_t color  = (bypassing) ? CV_SILVER : vd[i];
                     Color c1(color), c2(color);
                     c2.alpha(0.9);
 
-                    float ax = dx*(logf(c->fDotIn*zx));
-                    float ay = height + dy*(logf(c->fDotOut*zy));
+                    float ax = dx*(logf(d->vDotIn[i]*zx));
+                    float ay = height + dy*(logf(d->vDotOut[i]*zy));
 
                     cv->radial_gradient(ax, ay, c1, c2, 12);
                     cv->set_color_rgb(0);
@@ -1386,81 +2632,132 @@ namespace lsp
 
                 v->begin_object(c, sizeof(channel_t));
                 {
-                    v->write_object("sBypass", &c->sBypass);
                     v->write_object("sSC", &c->sSC);
-                    v->write_object("sSCEq", &c->sSCEq);
                     v->write_object("sComp", &c->sComp);
-                    v->write_object("sLaDelay", &c->sLaDelay);
-                    v->write_object("sInDelay", &c->sInDelay);
-                    v->write_object("sOutDelay", &c->sOutDelay);
-                    v->write_object("sDryDelay", &c->sDryDelay);
-
-                    v->begin_array("sGraph", c->sGraph, G_TOTAL);
-                    for (size_t j=0; j<G_TOTAL; ++j)
-                        v->write_object(&c->sGraph[j]);
-                    v->end_array();
+                    v->write_object("sGainComp", &c->sGainComp);
+                    v->write_object("sDelay", &c->sDelay);
 
                     v->write("vIn", c->vIn);
                     v->write("vOut", c->vOut);
                     v->write("vSc", c->vSc);
                     v->write("vEnv", c->vEnv);
                     v->write("vGain", c->vGain);
+                    v->write("vDry", c->vDry);
+                    v->write("vFbHistory", c->vFbHistory);
+                    v->write("vDelayIn", c->vDelayIn);
+                    v->write("vDelayDry", c->vDelayDry);
+                    v->write("nLookahead", c->nLookahead);
+                    v->write("nOldLookahead", c->nOldLookahead);
+                    v->write("nNewLookahead", c->nNewLookahead);
+                    v->write("nScPad", c->nScPad);
                     v->write("bScListen", c->bScListen);
-                    v->write("nSync", c->nSync);
                     v->write("nScType", c->nScType);
-                    v->write("fMakeup", c->fMakeup);
                     v->write("fFeedback", c->fFeedback);
                     v->write("fDryGain", c->fDryGain);
                     v->write("fWetGain", c->fWetGain);
-                    v->write("fDotIn", c->fDotIn);
-                    v->write("fDotOut", c->fDotOut);
-
-                    v->write("pIn", c->pIn);
-                    v->write("pOut", c->pOut);
-                    v->write("pSC", c->pSC);
-                    v->write("pShmIn", c->pShmIn);
-                    v->begin_array("pGraph", c->pGraph, G_TOTAL);
+                    v->write("fEnvLevel", c->fEnvLevel);
+                    v->write("fGainLevel", c->fGainLevel);
+                    v->write("fIdleLevel", c->fIdleLevel);
+
+                    const channel_aux_t *ca = c->pAux;
+                    v->begin_object("pAux", ca, sizeof(channel_aux_t));
+                    {
+                        v->write_object("sDecim", &ca->sDecim);
+                        v->write_object("sDSC", &ca->sDSC);
+                        v->begin_array("vDSCEq", ca->vDSCEq, channels);
+                        for (size_t j=0; j<channels; ++j)
+                            v->write_object(&ca->vDSCEq[j]);
+                        v->end_array();
+                        v->write_object("sDGain", &ca->sDGain);
+                        v->write_object("sSCEq", &ca->sSCEq);
+                        v->write_object("sBypass", &ca->sBypass);
+
+                        v->begin_array("sGraph", ca->sGraph, G_TOTAL);
+                        for (size_t j=0; j<G_TOTAL; ++j)
+                            v->write_object(&ca->sGraph[j]);
+                        v->end_array();
+
+                        v->begin_array("sHistory", ca->sHistory, G_TOTAL);
+                        for (size_t j=0; j<G_TOTAL; ++j)
+                            v->write_object(&ca->sHistory[j]);
+                        v->end_array();
+
+                        v->write("nSync", ca->nSync);
+                        v->write("nUpdate", ca->nUpdate);
+                        v->write("nScSource", ca->nScSource);
+                        v->write("fMakeup", ca->fMakeup);
+                        v->write("fDotIn", ca->fDotIn);
+                        v->write("fDotOut", ca->fDotOut);
+                        v->begin_object("sCurveKey", &ca->sCurveKey, sizeof(curve_key_t));
+                        {
+                            v->write("nMode", ca->sCurveKey.nMode);
+                            v->write("fThreshold", ca->sCurveKey.fThreshold);
+                            v->write("fBThresh", ca->sCurveKey.fBThresh);
+                            v->write("fBoost", ca->sCurveKey.fBoost);
+                            v->write("fRatio", ca->sCurveKey.fRatio);
+                            v->write("fKnee", ca->sCurveKey.fKnee);
+                            v->write("fMakeup", ca->sCurveKey.fMakeup);
+                        }
+                        v->end_object();
+                        v->write("vScBuf", ca->vScBuf);
+                        v->write("vEnvBuf", ca->vEnvBuf);
+                        v->write("vGainBuf", ca->vGainBuf);
+                        v->write("vGainCurve", ca->vGainCurve);
+                        v->write("pGainCurve", ca->pGainCurve);
+                    }
+                    v->end_object();
+
+                    v->write("pPorts", c->pPorts);
+                    v->writev("vParams", c->pPorts->vParams, CP_TOTAL);
+
+                    v->write("pIn", c->pPorts->pIn);
+                    v->write("pOut", c->pPorts->pOut);
+                    v->write("pSC", c->pPorts->pSC);
+                    v->write("pShmIn", c->pPorts->pShmIn);
+                    v->begin_array("pGraph", c->pPorts->pGraph, G_TOTAL);
                     for (size_t j=0; j<G_TOTAL; ++j)
-                        v->write(c->pGraph[j]);
+                        v->write(c->pPorts->pGraph[j]);
                     v->end_array();
-                    v->begin_array("pMeter", c->pGraph, M_TOTAL);
+                    v->begin_array("pMeter", c->pPorts->pGraph, M_TOTAL);
                     for (size_t j=0; j<M_TOTAL; ++j)
-                        v->write(c->pMeter[j]);
+                        v->write(c->pPorts->pMeter[j]);
                     v->end_array();
 
-                    v->write("pScType", c->pScType);
-                    v->write("pScMode", c->pScMode);
-                    v->write("pScLookahead", c->pScLookahead);
-                    v->write("pScListen", c->pScListen);
-                    v->write("pScSource", c->pScSource);
-                    v->write("pScReactivity", c->pScReactivity);
-                    v->write("pScPreamp", c->pScPreamp);
-                    v->write("pScHpfMode", c->pScHpfMode);
-                    v->write("pScHpfFreq", c->pScHpfFreq);
-                    v->write("pScLpfMode", c->pScLpfMode);
-                    v->write("pScLpfFreq", c->pScLpfFreq);
-
-                    v->write("pMode", c->pMode);
-                    v->write("pAttackLvl", c->pAttackLvl);
-                    v->write("pReleaseLvl", c->pReleaseLvl);
-                    v->write("pAttackTime", c->pAttackTime);
-                    v->write("pReleaseTime", c->pReleaseTime);
-                    v->write("pHoldTime", c->pHoldTime);
-                    v->write("pRatio", c->pRatio);
-                    v->write("pKnee", c->pKnee);
-                    v->write("pBThresh", c->pBThresh);
-                    v->write("pBoost", c->pBoost);
-                    v->write("pMakeup", c->pMakeup);
-
-                    v->write("pDryGain", c->pDryGain);
-                    v->write("pWetGain", c->pWetGain);
-                    v->write("pDryWet", c->pDryWet);
-                    v->write("pCurve", c->pCurve);
-                    v->write("pReleaseOut", c->pReleaseOut);
+                    v->write("pScType", c->pPorts->pScType);
+                    v->write("pScMode", c->pPorts->pScMode);
+                    v->write("pScLookahead", c->pPorts->pScLookahead);
+                    v->write("pScListen", c->pPorts->pScListen);
+                    v->write("pScSource", c->pPorts->pScSource);
+                    v->write("pScReactivity", c->pPorts->pScReactivity);
+                    v->write("pScPreamp", c->pPorts->pScPreamp);
+                    v->write("pScHpfMode", c->pPorts->pScHpfMode);
+                    v->write("pScHpfFreq", c->pPorts->pScHpfFreq);
+                    v->write("pScLpfMode", c->pPorts->pScLpfMode);
+                    v->write("pScLpfFreq", c->pPorts->pScLpfFreq);
+
+                    v->write("pMode", c->pPorts->pMode);
+                    v->write("pAttackLvl", c->pPorts->pAttackLvl);
+                    v->write("pReleaseLvl", c->pPorts->pReleaseLvl);
+                    v->write("pAttackTime", c->pPorts->pAttackTime);
+                    v->write("pReleaseTime", c->pPorts->pReleaseTime);
+                    v->write("pHoldTime", c->pPorts->pHoldTime);
+                    v->write("pRatio", c->pPorts->pRatio);
+                    v->write("pKnee", c->pPorts->pKnee);
+                    v->write("pBThresh", c->pPorts->pBThresh);
+                    v->write("pBoost", c->pPorts->pBoost);
+                    v->write("pMakeup", c->pPorts->pMakeup);
+
+                    v->write("pDryGain", c->pPorts->pDryGain);
+                    v->write("pWetGain", c->pPorts->pWetGain);
+                    v->write("pDryWet", c->pPorts->pDryWet);
+                    v->write("pCurve", c->pPorts->pCurve);
+                    v->write("pReleaseOut", c->pPorts->pReleaseOut);
+                    v->write("pCtlError", c->pPorts->pCtlError);
                 }
                 v->end_object();
             }
             v->end_array();
+            v->write("vPorts", vPorts);
 
             v->write("vCurve", vCurve);
             v->write("vTime", vTime);
@@ -1468,12 +2765,40 @@ namespace lsp
             v->write("bClear", bClear);
             v->write("bMSListen", bMSListen);
             v->write("bStereoSplit", bStereoSplit);
+            v->write("bFbBlock", bFbBlock);
+            v->write("bScDecim", bScDecim);
             v->write("fInGain", fInGain);
+            v->write("nLatency", nLatency);
+            v->write("nBlockMode", nBlockMode);
+            v->write("nGainComp", nGainComp);
+            v->write("nCtlStep", nCtlStep);
+            v->write("nHostBlock", nHostBlock);
+            v->write("nChunkSize", nChunkSize);
+            v->write("nOldLatency", nOldLatency);
+            v->write("nFade", nFade);
+            v->write("bDelaySync", bDelaySync);
+            v->write("nFadeLength", nFadeLength);
+            v->write("bMetering", bMetering);
+            v->write("nCurveVersion", nCurveVersion);
+            v->write("nDisplayPeriod", nDisplayPeriod);
+            v->write("nDisplayDelay", nDisplayDelay);
+            v->write("nHistoryPeriod", nHistoryPeriod);
+            v->write("nHistoryPhase", nHistoryPhase);
+            v->write("nHistoryPoints", nHistoryPoints);
+            v->write("nHistoryZoom", nHistoryZoom);
+            v->write("bIdle", bIdle);
+            v->write("nIdleSamples", nIdleSamples);
+            v->write("nIdleLimit", nIdleLimit);
+            v->write("fOutGain", fOutGain);
+            v->write("nUpdate", nUpdate);
+            v->write("nReconfigs", nReconfigs);
+            v->write("nReconfigTotal", nReconfigTotal);
             v->write("bUISync", bUISync);
             v->write("pIDisplay", pIDisplay);
 
             v->begin_object("sPremix", &sPremix, sizeof(premix_t));
             {
+                v->write("nRoutes", sPremix.nRoutes);
                 v->write("fInToSc", sPremix.fInToSc);
                 v->write("fInToLink", sPremix.fInToLink);
                 v->write("fLinkToIn", sPremix.fLinkToIn);
@@ -1503,6 +2828,12 @@ namespace lsp
             v->write("pOutGain", pOutGain);
             v->write("pPause", pPause);
             v->write("pClear", pClear);
+            v->write("pFbMode", pFbMode);
+            v->write("pBlockMode", pBlockMode);
+            v->write("pHistoryZoom", pHistoryZoom);
+            v->write("pGainComp", pGainComp);
+            v->write("pCtlStep", pCtlStep);
+            v->write("pScDecim", pScDecim);
             v->write("pMSListen", pMSListen);
             v->write("pStereoSplit", pStereoSplit);
             v->write("pScSpSource", pScSpSource);
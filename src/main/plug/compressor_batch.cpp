@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <private/plugins/compressor_batch.h>
+
+#include <math.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        CompressorBatch::CompressorBatch()
+        {
+            construct();
+        }
+
+        CompressorBatch::~CompressorBatch()
+        {
+            destroy();
+        }
+
+        void CompressorBatch::construct()
+        {
+            vGainComp       = NULL;
+            vTables         = NULL;
+            vEnvelope       = NULL;
+            vPeak           = NULL;
+            vTauAttack      = NULL;
+            vTauRelease     = NULL;
+            vThresh         = NULL;
+            vPreamp         = NULL;
+            vDry            = NULL;
+            vWet            = NULL;
+            vCounter        = NULL;
+            vHold           = NULL;
+            vBuffer         = NULL;
+            nLanes          = 0;
+            nCapacity       = 0;
+            nWidth          = 0;
+            pData           = NULL;
+        }
+
+        void CompressorBatch::destroy()
+        {
+            if (vGainComp != NULL)
+            {
+                for (size_t i=0; i<nCapacity; ++i)
+                    vGainComp[i].destroy();
+            }
+
+            if (pData != NULL)
+            {
+                free_aligned(pData);
+                pData           = NULL;
+            }
+
+            construct();
+        }
+
+        bool CompressorBatch::init(size_t lanes, size_t width)
+        {
+            if ((width != 4) && (width != 8) && (width != 16))
+                return false;
+
+            destroy();
+
+            // Padding lanes of the last group are processed with silence
+            const size_t capacity   = align_size(lanes, width);
+            const size_t gc_size    = align_size(sizeof(GainComputer) * capacity, DEFAULT_ALIGN);
+            const size_t tab_size   = align_size(sizeof(const float *) * capacity, DEFAULT_ALIGN);
+            const size_t arr_size   = align_size(sizeof(float) * capacity, DEFAULT_ALIGN);
+            const size_t buf_size   = BLOCK_SIZE * (width * 2 + 1) * sizeof(float);
+            const size_t allocate   = gc_size + tab_size + arr_size * 10 + buf_size;
+
+            uint8_t *ptr            = alloc_aligned<uint8_t>(pData, allocate);
+            if (ptr == NULL)
+                return false;
+
+            vGainComp               = advance_ptr_bytes<GainComputer>(ptr, gc_size);
+            vTables                 = advance_ptr_bytes<const float *>(ptr, tab_size);
+            vEnvelope               = advance_ptr_bytes<float>(ptr, arr_size);
+            vPeak                   = advance_ptr_bytes<float>(ptr, arr_size);
+            vTauAttack              = advance_ptr_bytes<float>(ptr, arr_size);
+            vTauRelease             = advance_ptr_bytes<float>(ptr, arr_size);
+            vThresh                 = advance_ptr_bytes<float>(ptr, arr_size);
+            vPreamp                 = advance_ptr_bytes<float>(ptr, arr_size);
+            vDry                    = advance_ptr_bytes<float>(ptr, arr_size);
+            vWet                    = advance_ptr_bytes<float>(ptr, arr_size);
+            vCounter                = advance_ptr_bytes<float>(ptr, arr_size);
+            vHold                   = advance_ptr_bytes<float>(ptr, arr_size);
+            vBuffer                 = advance_ptr_bytes<float>(ptr, buf_size);
+
+            nLanes                  = lanes;
+            nCapacity               = capacity;
+            nWidth                  = width;
+
+            for (size_t i=0; i<capacity; ++i)
+                vGainComp[i].construct();
+
+            for (size_t i=0; i<capacity; ++i)
+            {
+                GainComputer *gc        = &vGainComp[i];
+                if (!gc->init())
+                    return false;
+
+                vTables[i]              = gc->table();
+                vTauAttack[i]           = gc->tau_attack();
+                vTauRelease[i]          = gc->tau_release();
+                vThresh[i]              = gc->release_threshold();
+                vHold[i]                = float(gc->hold());
+                vPreamp[i]              = 1.0f;
+                vDry[i]                 = 0.0f;
+                vWet[i]                 = 1.0f;
+            }
+            clear();
+
+            return true;
+        }
+
+        void CompressorBatch::update(size_t lane, dspu::Compressor *comp, size_t sample_rate)
+        {
+            GainComputer *gc    = &vGainComp[lane];
+            gc->update(comp, sample_rate);
+
+            vTauAttack[lane]    = gc->tau_attack();
+            vTauRelease[lane]   = gc->tau_release();
+            vThresh[lane]       = gc->release_threshold();
+            vHold[lane]         = float(gc->hold());
+        }
+
+        void CompressorBatch::set_gains(size_t lane, float preamp, float dry, float wet)
+        {
+            vPreamp[lane]       = preamp;
+            vDry[lane]          = dry;
+            vWet[lane]          = wet;
+        }
+
+        void CompressorBatch::clear()
+        {
+            for (size_t i=0; i<nCapacity; ++i)
+            {
+                vEnvelope[i]        = 0.0f;
+                vPeak[i]            = 0.0f;
+                vCounter[i]         = 0.0f;
+            }
+        }
+
+        template <size_t W>
+        void CompressorBatch::process_group(size_t first, float * const *out, const float * const *in, const float * const *sc, size_t samples)
+        {
+            float *s            = vBuffer;
+            float *e            = &vBuffer[BLOCK_SIZE * W];
+            float *g            = &vBuffer[BLOCK_SIZE * W * 2];
+            const size_t lanes  = lsp_min(size_t(nLanes - first), W);
+
+            kernels::envelope_state_t st;
+            st.vEnvelope        = &vEnvelope[first];
+            st.vPeak            = &vPeak[first];
+            st.vCounter         = &vCounter[first];
+            st.vTauAttack       = &vTauAttack[first];
+            st.vTauRelease      = &vTauRelease[first];
+            st.vThresh          = &vThresh[first];
+            st.vHold            = &vHold[first];
+
+            for (size_t offset=0; offset < samples; )
+            {
+                const size_t to_do  = lsp_min(samples - offset, BLOCK_SIZE);
+
+                // Interleave the peak-detected sidechain of lanes
+                if (lanes < W)
+                    dsp::fill_zero(s, to_do * W);
+                for (size_t j=0; j<lanes; ++j)
+                {
+                    const float *src    = &in[first + j][offset];
+                    const float *scs    = ((sc != NULL) && (sc[first + j] != NULL)) ? &sc[first + j][offset] : src;
+                    const float preamp  = vPreamp[first + j];
+                    for (size_t i=0; i<to_do; ++i)
+                        s[i*W + j]          = fabsf(scs[i]) * preamp;
+                }
+
+                // Update envelopes of all lanes in lockstep
+                kernels::envelope(e, s, &st, W, to_do);
+
+                // Look up the gain of each lane and apply it with the dry/wet mix
+                for (size_t j=0; j<lanes; ++j)
+                {
+                    const float *table  = vTables[first + j];
+                    const float *env    = &e[j];
+                    const float *src    = &in[first + j][offset];
+                    float *dst          = &out[first + j][offset];
+
+                    for (size_t i=0; i<to_do; ++i)
+                        g[i]                = GainComputer::lookup(table, env[i*W]);
+                    dsp::mul2(g, src, to_do);
+                    dsp::mix_copy2(dst, g, src, vWet[first + j], vDry[first + j], to_do);
+                }
+
+                offset             += to_do;
+            }
+        }
+
+        void CompressorBatch::process(float * const *out, const float * const *in, const float * const *sc, size_t samples)
+        {
+            for (size_t first=0; first < nLanes; first += nWidth)
+            {
+                switch (nWidth)
+                {
+                    case 4:
+                        process_group<4>(first, out, in, sc, samples);
+                        break;
+                    case 8:
+                        process_group<8>(first, out, in, sc, samples);
+                        break;
+                    case 16:
+                        process_group<16>(first, out, in, sc, samples);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        void CompressorBatch::dump(dspu::IStateDumper *v) const
+        {
+            v->begin_array("vGainComp", vGainComp, nCapacity);
+            {
+                for (size_t i=0; i<nCapacity; ++i)
+                    v->write_object(&vGainComp[i]);
+            }
+            v->end_array();
+
+            v->write("vTables", vTables);
+            v->writev("vEnvelope", vEnvelope, nCapacity);
+            v->writev("vPeak", vPeak, nCapacity);
+            v->writev("vTauAttack", vTauAttack, nCapacity);
+            v->writev("vTauRelease", vTauRelease, nCapacity);
+            v->writev("vThresh", vThresh, nCapacity);
+            v->writev("vPreamp", vPreamp, nCapacity);
+            v->writev("vDry", vDry, nCapacity);
+            v->writev("vWet", vWet, nCapacity);
+            v->writev("vCounter", vCounter, nCapacity);
+            v->writev("vHold", vHold, nCapacity);
+            v->write("vBuffer", vBuffer);
+            v->write("nLanes", nLanes);
+            v->write("nCapacity", nCapacity);
+            v->write("nWidth", nWidth);
+            v->write("pData", pData);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <private/plugins/compressor_decimator.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        SidechainDecimator::SidechainDecimator()
+        {
+            construct();
+        }
+
+        SidechainDecimator::~SidechainDecimator()
+        {
+            destroy();
+        }
+
+        void SidechainDecimator::construct()
+        {
+            for (size_t i=0; i<CHANNELS_MAX; ++i)
+            {
+                input_t *in     = &vInputs[i];
+                in->vStage      = NULL;
+                in->vData       = NULL;
+                in->pPreEq      = NULL;
+            }
+            for (size_t i=0; i<STREAMS_MAX; ++i)
+            {
+                stream_t *s     = &vStreams[i];
+                s->vData        = NULL;
+                s->fValue       = 0.0f;
+                s->fDelta       = 0.0f;
+                s->bInit        = false;
+            }
+
+            vWindow         = NULL;
+            nChannels       = 0;
+            nStreams        = 0;
+            nMaxFactor      = 1;
+            nMaxSamples     = 0;
+            nFactor         = 1;
+            nPhase          = 0;
+            nFirst          = 0;
+            nPoints         = 0;
+            pData           = NULL;
+        }
+
+        void SidechainDecimator::destroy()
+        {
+            if (pData != NULL)
+            {
+                free_aligned(pData);
+                pData           = NULL;
+            }
+            construct();
+        }
+
+        bool SidechainDecimator::init(size_t channels, size_t streams, size_t max_factor, size_t max_samples)
+        {
+            if ((channels > CHANNELS_MAX) || (streams > STREAMS_MAX) || (max_factor < 1))
+                return false;
+
+            // The stage buffer keeps 2*N-2 samples of history before the block
+            const size_t window_size    = align_size(max_factor * 2, DEFAULT_ALIGN / sizeof(float));
+            const size_t stage_size     = align_size(max_samples + max_factor * 2, DEFAULT_ALIGN / sizeof(float));
+            const size_t data_size      = align_size(max_samples, DEFAULT_ALIGN / sizeof(float));
+            const size_t allocate       = window_size + (stage_size + data_size) * channels + data_size * streams;
+
+            uint8_t *data       = NULL;
+            float *ptr          = alloc_aligned<float>(data, allocate);
+            if (ptr == NULL)
+                return false;
+
+            destroy();
+
+            vWindow             = ptr;
+            ptr                += window_size;
+            for (size_t i=0; i<channels; ++i)
+            {
+                input_t *in         = &vInputs[i];
+                in->vStage          = ptr;
+                ptr                += stage_size;
+                in->vData           = ptr;
+                ptr                += data_size;
+            }
+            for (size_t i=0; i<streams; ++i)
+            {
+                vStreams[i].vData   = ptr;
+                ptr                += data_size;
+            }
+
+            nChannels           = channels;
+            nStreams            = streams;
+            nMaxFactor          = max_factor;
+            nMaxSamples         = max_samples;
+            pData               = data;
+
+            dsp::fill_zero(vWindow, allocate);
+            vWindow[0]          = 1.0f;
+            clear();
+
+            return true;
+        }
+
+        void SidechainDecimator::set_factor(size_t factor)
+        {
+            factor              = lsp_limit(factor, size_t(1), size_t(nMaxFactor));
+            if ((factor == nFactor) || (vWindow == NULL))
+                return;
+
+            // Triangular window of 2*N-1 samples with unity gain at DC
+            nFactor             = factor;
+            const float norm    = 1.0f / float(factor * factor);
+            for (size_t i=0; i<factor; ++i)
+            {
+                vWindow[i]                  = float(i + 1) * norm;
+                vWindow[factor*2 - i - 2]   = vWindow[i];
+            }
+
+            clear();
+        }
+
+        void SidechainDecimator::clear()
+        {
+            for (size_t i=0; i<nChannels; ++i)
+                dsp::fill_zero(vInputs[i].vStage, nFactor * 2);
+            for (size_t i=0; i<nStreams; ++i)
+            {
+                stream_t *s     = &vStreams[i];
+                s->fValue       = 0.0f;
+                s->fDelta       = 0.0f;
+                s->bInit        = false;
+            }
+
+            // The first sample of the next block produces the decimated sample
+            nPhase          = nFactor - 1;
+            nFirst          = 0;
+            nPoints         = 0;
+        }
+
+        size_t SidechainDecimator::decimate(const float * const *in, size_t samples)
+        {
+            const size_t history    = nFactor * 2 - 2;
+            const size_t window     = history + 1;
+            const size_t first      = nFactor - nPhase - 1;
+
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                input_t *c          = &vInputs[i];
+                float *stage        = &c->vStage[history];
+                if (in[i] != NULL)
+                    dsp::copy(stage, in[i], samples);
+                else
+                    dsp::fill_zero(stage, samples);
+                if (c->pPreEq != NULL)
+                    c->pPreEq->process(stage, stage, samples);
+
+                // The stage buffer starting at offset contains the window ending at the decimated sample
+                size_t n            = 0;
+                for (size_t offset=first; offset < samples; offset += nFactor, ++n)
+                    c->vData[n]         = dsp::scalar_mul(&c->vStage[offset], vWindow, window);
+
+                dsp::move(c->vStage, &c->vStage[samples], history);
+            }
+
+            nFirst          = first;
+            nPoints         = (first < samples) ? (samples - first + nFactor - 1) / nFactor : 0;
+            nPhase          = (nPhase + samples) % nFactor;
+
+            return nPoints;
+        }
+
+        void SidechainDecimator::interpolate(float *dst, size_t index, size_t samples)
+        {
+            stream_t *s         = &vStreams[index];
+            if ((!s->bInit) && (nPoints > 0))
+            {
+                s->fValue           = s->vData[0];
+                s->bInit            = true;
+            }
+
+            // The value reaches the decimated sample in N samples after it has been computed
+            const float k       = 1.0f / float(nFactor);
+            size_t offset       = 0;
+            for (size_t i=0; i<nPoints; ++i)
+            {
+                const size_t last   = nFirst + i * nFactor;
+                for ( ; offset <= last; ++offset)
+                {
+                    s->fValue          += s->fDelta;
+                    dst[offset]         = s->fValue;
+                }
+                s->fDelta           = (s->vData[i] - s->fValue) * k;
+            }
+
+            for ( ; offset < samples; ++offset)
+            {
+                s->fValue          += s->fDelta;
+                dst[offset]         = s->fValue;
+            }
+        }
+
+        void SidechainDecimator::dump(dspu::IStateDumper *v) const
+        {
+            v->begin_array("vInputs", vInputs, nChannels);
+            {
+                for (size_t i=0; i<nChannels; ++i)
+                {
+                    const input_t *in   = &vInputs[i];
+                    v->begin_object(in, sizeof(input_t));
+                    {
+                        v->write("vStage", in->vStage);
+                        v->write("vData", in->vData);
+                        v->write("pPreEq", in->pPreEq);
+                    }
+                    v->end_object();
+                }
+            }
+            v->end_array();
+
+            v->begin_array("vStreams", vStreams, nStreams);
+            {
+                for (size_t i=0; i<nStreams; ++i)
+                {
+                    const stream_t *s   = &vStreams[i];
+                    v->begin_object(s, sizeof(stream_t));
+                    {
+                        v->write("vData", s->vData);
+                        v->write("fValue", s->fValue);
+                        v->write("fDelta", s->fDelta);
+                        v->write("bInit", s->bInit);
+                    }
+                    v->end_object();
+                }
+            }
+            v->end_array();
+
+            v->write("vWindow", vWindow);
+            v->write("nChannels", nChannels);
+            v->write("nStreams", nStreams);
+            v->write("nMaxFactor", nMaxFactor);
+            v->write("nMaxSamples", nMaxSamples);
+            v->write("nFactor", nFactor);
+            v->write("nPhase", nPhase);
+            v->write("nFirst", nFirst);
+            v->write("nPoints", nPoints);
+            v->write("pData", pData);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <private/plugins/compressor_delay.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        MultiTapDelay::MultiTapDelay()
+        {
+            construct();
+        }
+
+        MultiTapDelay::~MultiTapDelay()
+        {
+            destroy();
+        }
+
+        void MultiTapDelay::construct()
+        {
+            vData       = NULL;
+            nLanes      = 0;
+            nSize       = 0;
+            nStride     = 0;
+            nBlock      = 0;
+            nMaxDelay   = 0;
+            nHead       = 0;
+            pData       = NULL;
+        }
+
+        void MultiTapDelay::destroy()
+        {
+            if (pData != NULL)
+            {
+                free_aligned(pData);
+                pData       = NULL;
+            }
+            vData       = NULL;
+            nLanes      = 0;
+            nSize       = 0;
+            nStride     = 0;
+        }
+
+        bool MultiTapDelay::init(size_t lanes, size_t max_delay, size_t block)
+        {
+            // The oldest sample of the tap should not be overwritten by the appended block
+            const size_t size   = max_delay + block;
+            const size_t stride = align_size(size + block, DEFAULT_ALIGN / sizeof(float));
+
+            uint8_t *data       = NULL;
+            float *ptr          = alloc_aligned<float>(data, stride * lanes);
+            if (ptr == NULL)
+                return false;
+
+            destroy();
+
+            vData       = ptr;
+            nLanes      = lanes;
+            nSize       = size;
+            nStride     = stride;
+            nBlock      = block;
+            nMaxDelay   = max_delay;
+            nHead       = 0;
+            pData       = data;
+
+            return true;
+        }
+
+        void MultiTapDelay::clear()
+        {
+            if (vData != NULL)
+                dsp::fill_zero(vData, nStride * nLanes);
+        }
+
+        void MultiTapDelay::append(size_t lane, const float *src, size_t count)
+        {
+            float *buf      = &vData[lane * nStride];
+            size_t head     = nHead;
+
+            while (count > 0)
+            {
+                const size_t to_do  = lsp_min(count, nSize - head);
+                dsp::copy(&buf[head], src, to_do);
+
+                // Keep the mirror of the beginning of the ring buffer actual
+                if (head < nBlock)
+                    dsp::copy(&buf[head + nSize], src, lsp_min(to_do, nBlock - head));
+
+                src            += to_do;
+                count          -= to_do;
+                head           += to_do;
+                if (head >= nSize)
+                    head           -= nSize;
+            }
+        }
+
+        const float *MultiTapDelay::tap(size_t lane, size_t delay) const
+        {
+            const size_t pos    = (nHead >= delay) ? nHead - delay : nHead + nSize - delay;
+            return &vData[lane * nStride + pos];
+        }
+
+        void MultiTapDelay::advance(size_t count)
+        {
+            nHead          += count;
+            if (nHead >= nSize)
+                nHead          -= nSize;
+        }
+
+        void MultiTapDelay::dump(dspu::IStateDumper *v) const
+        {
+            v->write("vData", vData);
+            v->write("nLanes", nLanes);
+            v->write("nSize", nSize);
+            v->write("nStride", nStride);
+            v->write("nBlock", nBlock);
+            v->write("nMaxDelay", nMaxDelay);
+            v->write("nHead", nHead);
+            v->write("pData", pData);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
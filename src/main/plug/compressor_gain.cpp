@@ -0,0 +1,378 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/units.h>
+#include <private/plugins/compressor_gain.h>
+#include <private/plugins/compressor_kernels.h>
+
+#include <math.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        static constexpr size_t     GAIN_STEP_MAX       = 64;                       // Maximum number of samples between control points
+        static constexpr size_t     GAIN_STEP_DIV       = 16;                       // Attack time divider for the automatic step
+        static constexpr size_t     GAIN_PROBE_BITS     = 4;                        // Number of error probes per segment, log2
+
+        static inline float gain_point(size_t index, uint32_t frac)
+        {
+            gain_cast_t v;
+            v.u         = GAIN_BITS_MIN + uint32_t(index << GAIN_FRAC_BITS) + frac;
+            return v.f;
+        }
+
+        GainComputer::GainComputer()
+        {
+            construct();
+        }
+
+        GainComputer::~GainComputer()
+        {
+            destroy();
+        }
+
+        void GainComputer::construct()
+        {
+            vTable          = NULL;
+            fEnvelope       = 0.0f;
+            fPeak           = 0.0f;
+            fTauAttack      = 1.0f;
+            fTauRelease     = 1.0f;
+            fReleaseThresh  = 0.0f;
+            nHold           = 0;
+            nHoldCounter    = 0;
+            fMaxError       = 0.0f;
+            fAttack         = 0.0f;
+
+            nStepSetup      = 0;
+            nStep           = 1;
+            nPhase          = 1;
+            nCtlHold        = 0;
+            fCtlTauAttack   = 1.0f;
+            fCtlTauRelease  = 1.0f;
+            fCtlInput       = 0.0f;
+            fCtlEnv         = 0.0f;
+            fCtlGain        = 1.0f;
+            fEnvDelta       = 0.0f;
+            fGainDelta      = 0.0f;
+            fCtlError       = 0.0f;
+
+            pData           = NULL;
+        }
+
+        void GainComputer::destroy()
+        {
+            if (pData != NULL)
+            {
+                free_aligned(pData);
+                pData           = NULL;
+            }
+            vTable          = NULL;
+        }
+
+        bool GainComputer::init()
+        {
+            uint8_t *data       = NULL;
+            float *ptr          = alloc_aligned<float>(data, align_size(GAIN_POINTS + 1, DEFAULT_ALIGN / sizeof(float)));
+            if (ptr == NULL)
+                return false;
+
+            destroy();
+
+            vTable          = ptr;
+            pData           = data;
+            dsp::fill(vTable, 1.0f, GAIN_POINTS + 1);
+
+            return true;
+        }
+
+        void GainComputer::update(dspu::Compressor *comp, size_t sample_rate, bool table)
+        {
+            // Time constants, the envelope reaches 1/sqrt(2) of the step for the specified time
+            const float attack  = dspu::millis_to_samples(sample_rate, comp->attack());
+            const float release = dspu::millis_to_samples(sample_rate, comp->release());
+            fTauAttack      = 1.0f - expf(logf(1.0f - M_SQRT1_2) / attack);
+            fTauRelease     = 1.0f - expf(logf(1.0f - M_SQRT1_2) / release);
+            fReleaseThresh  = comp->release_threshold();
+            nHold           = dspu::millis_to_samples(sample_rate, comp->hold());
+            fAttack         = attack;
+            update_control();
+
+            if ((!table) || (vTable == NULL))
+                return;
+
+            // Evaluate the exact curve at the points of the table
+            for (size_t i=0; i<GAIN_POINTS; ++i)
+                vTable[i]       = gain_point(i, 0);
+            comp->reduction(vTable, vTable, GAIN_POINTS);
+            vTable[GAIN_POINTS] = vTable[GAIN_SEGMENTS];
+
+            // Bound the error of the linear interpolation. Each segment is split by probes into
+            // intervals. The curve is monotonic, so inside of the interval both the curve and the
+            // interpolated value stay within the range of their values at the probes around it.
+            constexpr size_t probes = GAIN_SEGMENTS << GAIN_PROBE_BITS;
+            constexpr size_t chunk  = 0x100;
+            float x[chunk], g[chunk];
+            float error     = 0.0f;
+            float prev_g    = vTable[0];
+            float prev_t    = vTable[0];
+
+            for (size_t off=1; off <= probes; off += chunk)
+            {
+                const size_t count  = lsp_min(probes + 1 - off, chunk);
+                for (size_t i=0; i<count; ++i)
+                {
+                    const size_t idx    = off + i;
+                    x[i]                = gain_point(idx >> GAIN_PROBE_BITS,
+                        uint32_t(idx & ((1 << GAIN_PROBE_BITS) - 1)) << (GAIN_FRAC_BITS - GAIN_PROBE_BITS));
+                }
+                comp->reduction(g, x, count);
+
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float t       = lookup(vTable, x[i]);
+                    const float lo      = lsp_min(lsp_min(prev_g, g[i]), lsp_min(prev_t, t));
+                    const float hi      = lsp_max(lsp_max(prev_g, g[i]), lsp_max(prev_t, t));
+                    if (lo > 0.0f)
+                        error               = lsp_max(error, (hi - lo) / lo);
+                    prev_g              = g[i];
+                    prev_t              = t;
+                }
+            }
+
+            fMaxError       = error;
+        }
+
+        void GainComputer::update_control()
+        {
+            // The step is limited to keep the envelope change per step small
+            size_t step     = (nStepSetup > 0) ? nStepSetup : size_t(fAttack) / GAIN_STEP_DIV;
+            nStep           = lsp_limit(step, size_t(1), GAIN_STEP_MAX);
+            nPhase          = lsp_min(nPhase, nStep);
+
+            fCtlTauAttack   = 1.0f - powf(1.0f - fTauAttack, nStep);
+            fCtlTauRelease  = 1.0f - powf(1.0f - fTauRelease, nStep);
+            nCtlHold        = (nHold + nStep - 1) / nStep;
+
+            // The control point is computed from the peak of the whole step and is reached
+            // by the interpolation at the end of the next step, so the interpolated envelope
+            // deviates from the per-sample envelope by at most its change over two steps
+            const float tau = 1.0f - lsp_max(fCtlTauAttack, fCtlTauRelease);
+            fCtlError       = 1.0f - tau * tau;
+        }
+
+        void GainComputer::set_step(size_t step)
+        {
+            if (nStepSetup == step)
+                return;
+            nStepSetup      = step;
+            update_control();
+        }
+
+        void GainComputer::clear()
+        {
+            reset(0.0f);
+        }
+
+        void GainComputer::reset(float env)
+        {
+            fEnvelope       = env;
+            fPeak           = env;
+            nHoldCounter    = 0;
+
+            nPhase          = nStep;
+            fCtlInput       = 0.0f;
+            fCtlEnv         = env;
+            fCtlGain        = (vTable != NULL) ? reduction(env) : 1.0f;
+            fEnvDelta       = 0.0f;
+            fGainDelta      = 0.0f;
+        }
+
+        inline float GainComputer::envelope(float s, float tau_attack, float tau_release, uint32_t hold)
+        {
+            const float d   = s - fEnvelope;
+            if (d < 0.0f)
+            {
+                // Release, keep the peak while holding
+                if (nHoldCounter > 0)
+                    --nHoldCounter;
+                else
+                {
+                    fEnvelope      += ((fEnvelope > fReleaseThresh) ? tau_release : tau_attack) * d;
+                    fPeak           = fEnvelope;
+                }
+            }
+            else
+            {
+                // Attack, restart the hold when the new peak has been reached
+                fEnvelope      += tau_attack * d;
+                if (fEnvelope >= fPeak)
+                {
+                    fPeak           = fEnvelope;
+                    nHoldCounter    = hold;
+                }
+            }
+
+            return fEnvelope;
+        }
+
+        void GainComputer::process(float *out, float *env, const float *in, size_t samples)
+        {
+            for (size_t i=0; i<samples; ++i)
+                out[i]          = envelope(in[i], fTauAttack, fTauRelease, nHold);
+            if (env != NULL)
+                dsp::copy(env, out, samples);
+            for (size_t i=0; i<samples; ++i)
+                out[i]          = reduction(out[i]);
+        }
+
+        float GainComputer::process(float *env, float s)
+        {
+            const float e   = envelope(s, fTauAttack, fTauRelease, nHold);
+            if (env != NULL)
+                *env            = e;
+            return reduction(e);
+        }
+
+        void GainComputer::process_envelope(float *env, const float *in, size_t samples)
+        {
+            for (size_t i=0; i<samples; ++i)
+                env[i]          = envelope(in[i], fTauAttack, fTauRelease, nHold);
+        }
+
+        float GainComputer::process_envelope(float s)
+        {
+            return envelope(s, fTauAttack, fTauRelease, nHold);
+        }
+
+        void GainComputer::process_x2(GainComputer * const *gc, float * const *out, float * const *env, const float * const *in, size_t samples)
+        {
+            float envelope[2], peak[2], counter[2], tau_attack[2], tau_release[2], thresh[2], hold[2];
+
+            for (size_t j=0; j<2; ++j)
+            {
+                const GainComputer *g   = gc[j];
+                envelope[j]     = g->fEnvelope;
+                peak[j]         = g->fPeak;
+                counter[j]      = float(g->nHoldCounter);
+                tau_attack[j]   = g->fTauAttack;
+                tau_release[j]  = g->fTauRelease;
+                thresh[j]       = g->fReleaseThresh;
+                hold[j]         = float(g->nHold);
+            }
+
+            kernels::envelope_state_t st;
+            st.vEnvelope    = envelope;
+            st.vPeak        = peak;
+            st.vCounter     = counter;
+            st.vTauAttack   = tau_attack;
+            st.vTauRelease  = tau_release;
+            st.vThresh      = thresh;
+            st.vHold        = hold;
+
+            // Update both envelope followers in lockstep, then look up the gain of each channel
+            kernels::envelope_planar(out, in, &st, 2, samples);
+            for (size_t j=0; j<2; ++j)
+            {
+                const float *table  = gc[j]->vTable;
+                float *dst          = out[j];
+                if (env[j] != NULL)
+                    dsp::copy(env[j], dst, samples);
+                for (size_t i=0; i<samples; ++i)
+                    dst[i]              = lookup(table, dst[i]);
+            }
+
+            for (size_t j=0; j<2; ++j)
+            {
+                GainComputer *g     = gc[j];
+                g->fEnvelope        = envelope[j];
+                g->fPeak            = peak[j];
+                g->nHoldCounter     = uint32_t(counter[j]);
+            }
+        }
+
+        void GainComputer::process_control(float *out, float *env, const float *in, size_t samples)
+        {
+            for (size_t offset=0; offset < samples; )
+            {
+                // Compute the next control point when the previous one has been reached
+                if (nPhase >= nStep)
+                {
+                    const float e   = envelope(fCtlInput, fCtlTauAttack, fCtlTauRelease, nCtlHold);
+                    const float k   = 1.0f / float(nStep);
+                    fEnvDelta       = (e - fCtlEnv) * k;
+                    fGainDelta      = (reduction(e) - fCtlGain) * k;
+                    fCtlInput       = 0.0f;
+                    nPhase          = 0;
+                }
+
+                // Interpolate between control points
+                const size_t to_do  = lsp_min(samples - offset, size_t(nStep - nPhase));
+                fCtlInput           = lsp_max(fCtlInput, dsp::max(&in[offset], to_do));
+
+                float *dst          = &out[offset];
+                float *denv         = (env != NULL) ? &env[offset] : NULL;
+                for (size_t i=0; i<to_do; ++i)
+                {
+                    fCtlEnv            += fEnvDelta;
+                    fCtlGain           += fGainDelta;
+                    dst[i]              = fCtlGain;
+                    if (denv != NULL)
+                        denv[i]             = fCtlEnv;
+                }
+
+                nPhase             += to_do;
+                offset             += to_do;
+            }
+        }
+
+        void GainComputer::dump(dspu::IStateDumper *v) const
+        {
+            v->write("vTable", vTable);
+            v->write("fEnvelope", fEnvelope);
+            v->write("fPeak", fPeak);
+            v->write("fTauAttack", fTauAttack);
+            v->write("fTauRelease", fTauRelease);
+            v->write("fReleaseThresh", fReleaseThresh);
+            v->write("nHold", nHold);
+            v->write("nHoldCounter", nHoldCounter);
+            v->write("fMaxError", fMaxError);
+            v->write("fAttack", fAttack);
+            v->write("nStepSetup", nStepSetup);
+            v->write("nStep", nStep);
+            v->write("nPhase", nPhase);
+            v->write("nCtlHold", nCtlHold);
+            v->write("fCtlTauAttack", fCtlTauAttack);
+            v->write("fCtlTauRelease", fCtlTauRelease);
+            v->write("fCtlInput", fCtlInput);
+            v->write("fCtlEnv", fCtlEnv);
+            v->write("fCtlGain", fCtlGain);
+            v->write("fEnvDelta", fEnvDelta);
+            v->write("fGainDelta", fGainDelta);
+            v->write("fCtlError", fCtlError);
+            v->write("pData", pData);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
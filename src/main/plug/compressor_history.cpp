@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <private/plugins/compressor_history.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        HistoryPyramid::HistoryPyramid()
+        {
+            construct();
+        }
+
+        HistoryPyramid::~HistoryPyramid()
+        {
+            destroy();
+        }
+
+        void HistoryPyramid::construct()
+        {
+            vLevels     = NULL;
+            nLevels     = 0;
+            nPoints     = 0;
+            bMinimum    = false;
+            pData       = NULL;
+        }
+
+        void HistoryPyramid::destroy()
+        {
+            if (pData != NULL)
+            {
+                free_aligned(pData);
+                pData       = NULL;
+            }
+            vLevels     = NULL;
+            nLevels     = 0;
+            nPoints     = 0;
+        }
+
+        bool HistoryPyramid::init(size_t points, const size_t *ratios, size_t levels)
+        {
+            const size_t szof_levels    = align_size(sizeof(level_t) * levels, DEFAULT_ALIGN);
+            const size_t szof_points    = align_size(sizeof(float) * points, DEFAULT_ALIGN);
+            const size_t to_alloc       = szof_levels + szof_points * levels * 2;
+
+            uint8_t *data       = NULL;
+            uint8_t *ptr        = alloc_aligned<uint8_t>(data, to_alloc);
+            if (ptr == NULL)
+                return false;
+
+            destroy();
+
+            vLevels     = advance_ptr_bytes<level_t>(ptr, szof_levels);
+            for (size_t i=0; i<levels; ++i)
+            {
+                level_t *l      = &vLevels[i];
+
+                l->vMin         = advance_ptr_bytes<float>(ptr, szof_points);
+                l->vMax         = advance_ptr_bytes<float>(ptr, szof_points);
+                l->nRatio       = lsp_max(ratios[i], size_t(1));
+                l->nCount       = 0;
+                l->nHead        = 0;
+                l->fMin         = 0.0f;
+                l->fMax         = 0.0f;
+            }
+
+            nLevels     = levels;
+            nPoints     = points;
+            pData       = data;
+
+            clear(0.0f);
+
+            return true;
+        }
+
+        void HistoryPyramid::clear(float value)
+        {
+            for (size_t i=0; i<nLevels; ++i)
+            {
+                level_t *l      = &vLevels[i];
+
+                dsp::fill(l->vMin, value, nPoints);
+                dsp::fill(l->vMax, value, nPoints);
+                l->nCount       = 0;
+                l->nHead        = 0;
+                l->fMin         = value;
+                l->fMax         = value;
+            }
+        }
+
+        void HistoryPyramid::push(const float *src, size_t count)
+        {
+            for (size_t i=0; i<count; ++i)
+            {
+                float vmin      = src[i];
+                float vmax      = src[i];
+
+                // Propagate the point up while the points of levels get completed
+                for (size_t j=0; j<nLevels; ++j)
+                {
+                    level_t *l      = &vLevels[j];
+                    if (l->nCount > 0)
+                    {
+                        l->fMin         = lsp_min(l->fMin, vmin);
+                        l->fMax         = lsp_max(l->fMax, vmax);
+                    }
+                    else
+                    {
+                        l->fMin         = vmin;
+                        l->fMax         = vmax;
+                    }
+
+                    if ((++l->nCount) < l->nRatio)
+                        break;
+
+                    l->vMin[l->nHead]   = l->fMin;
+                    l->vMax[l->nHead]   = l->fMax;
+                    l->nCount           = 0;
+                    if ((++l->nHead) >= nPoints)
+                        l->nHead            = 0;
+
+                    vmin            = l->fMin;
+                    vmax            = l->fMax;
+                }
+            }
+        }
+
+        void HistoryPyramid::read(size_t level, float *dst) const
+        {
+            const level_t *l    = &vLevels[level];
+            const float *src    = (bMinimum) ? l->vMin : l->vMax;
+            const size_t tail   = nPoints - l->nHead;
+
+            dsp::copy(dst, &src[l->nHead], tail);
+            dsp::copy(&dst[tail], src, l->nHead);
+        }
+
+        void HistoryPyramid::dump(dspu::IStateDumper *v) const
+        {
+            v->begin_array("vLevels", vLevels, nLevels);
+            for (size_t i=0; i<nLevels; ++i)
+            {
+                const level_t *l    = &vLevels[i];
+
+                v->begin_object(l, sizeof(level_t));
+                {
+                    v->write("vMin", l->vMin);
+                    v->write("vMax", l->vMax);
+                    v->write("nRatio", l->nRatio);
+                    v->write("nCount", l->nCount);
+                    v->write("nHead", l->nHead);
+                    v->write("fMin", l->fMin);
+                    v->write("fMax", l->fMax);
+                }
+                v->end_object();
+            }
+            v->end_array();
+
+            v->write("nLevels", nLevels);
+            v->write("nPoints", nPoints);
+            v->write("bMinimum", bMinimum);
+            v->write("pData", pData);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <private/plugins/compressor_kernels.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        namespace kernels
+        {
+            /**
+             * Branch-free form of the envelope follower of GainComputer for one lane
+             */
+            static inline float update(float s, float & e, float & p, float & c, float ta, float tr, float th, float h)
+            {
+                const float d       = s - e;
+                const bool attack   = d >= 0.0f;
+                const bool holding  = (!attack) && (c > 0.0f);
+                const float tau     = ((attack) || (e <= th)) ? ta : tr;
+
+                e                  += ((holding) ? 0.0f : tau) * d;
+                const bool reached  = (attack) && (e >= p);
+                p                   = ((reached) || ((!attack) && (!holding))) ? e : p;
+                c                   = (reached) ? h : c - ((holding) ? 1.0f : 0.0f);
+
+                return e;
+            }
+
+            template <size_t N>
+            static void envelope_lanes(float *env, const float *sc, const envelope_state_t *st, size_t count)
+            {
+                float e[N], p[N], c[N], ta[N], tr[N], th[N], h[N];
+                for (size_t j=0; j<N; ++j)
+                {
+                    e[j]                = st->vEnvelope[j];
+                    p[j]                = st->vPeak[j];
+                    c[j]                = st->vCounter[j];
+                    ta[j]               = st->vTauAttack[j];
+                    tr[j]               = st->vTauRelease[j];
+                    th[j]               = st->vThresh[j];
+                    h[j]                = st->vHold[j];
+                }
+
+                // The recursions of lanes are independent and run in the same iteration
+                for (size_t i=0; i<count; ++i, sc += N, env += N)
+                {
+                    for (size_t j=0; j<N; ++j)
+                        env[j]              = update(sc[j], e[j], p[j], c[j], ta[j], tr[j], th[j], h[j]);
+                }
+
+                for (size_t j=0; j<N; ++j)
+                {
+                    st->vEnvelope[j]    = e[j];
+                    st->vPeak[j]        = p[j];
+                    st->vCounter[j]     = c[j];
+                }
+            }
+
+            template <size_t N>
+            static void envelope_planar_lanes(float * const *env, const float * const *sc, const envelope_state_t *st, size_t count)
+            {
+                float e[N], p[N], c[N], ta[N], tr[N], th[N], h[N];
+                for (size_t j=0; j<N; ++j)
+                {
+                    e[j]                = st->vEnvelope[j];
+                    p[j]                = st->vPeak[j];
+                    c[j]                = st->vCounter[j];
+                    ta[j]               = st->vTauAttack[j];
+                    tr[j]               = st->vTauRelease[j];
+                    th[j]               = st->vThresh[j];
+                    h[j]                = st->vHold[j];
+                }
+
+                for (size_t i=0; i<count; ++i)
+                {
+                    for (size_t j=0; j<N; ++j)
+                        env[j][i]           = update(sc[j][i], e[j], p[j], c[j], ta[j], tr[j], th[j], h[j]);
+                }
+
+                for (size_t j=0; j<N; ++j)
+                {
+                    st->vEnvelope[j]    = e[j];
+                    st->vPeak[j]        = p[j];
+                    st->vCounter[j]     = c[j];
+                }
+            }
+
+            void envelope_planar(float * const *env, const float * const *sc, const envelope_state_t *st, size_t lanes, size_t count)
+            {
+                switch (lanes)
+                {
+                    case 2: envelope_planar_lanes<2>(env, sc, st, count); return;
+                    case 4: envelope_planar_lanes<4>(env, sc, st, count); return;
+                    default: break;
+                }
+
+                for (size_t i=0; i<count; ++i)
+                {
+                    for (size_t j=0; j<lanes; ++j)
+                        env[j][i]           = update(sc[j][i], st->vEnvelope[j], st->vPeak[j], st->vCounter[j],
+                                                st->vTauAttack[j], st->vTauRelease[j], st->vThresh[j], st->vHold[j]);
+                }
+            }
+
+            void envelope(float *env, const float *sc, const envelope_state_t *st, size_t lanes, size_t count)
+            {
+                switch (lanes)
+                {
+                    case 2: envelope_lanes<2>(env, sc, st, count); return;
+                    case 4: envelope_lanes<4>(env, sc, st, count); return;
+                    case 8: envelope_lanes<8>(env, sc, st, count); return;
+                    case 16: envelope_lanes<16>(env, sc, st, count); return;
+                    default: break;
+                }
+
+                for (size_t i=0; i<count; ++i, sc += lanes, env += lanes)
+                {
+                    for (size_t j=0; j<lanes; ++j)
+                        env[j]              = update(sc[j], st->vEnvelope[j], st->vPeak[j], st->vCounter[j],
+                                                st->vTauAttack[j], st->vTauRelease[j], st->vThresh[j], st->vHold[j]);
+                }
+            }
+        } /* namespace kernels */
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <private/plugins/compressor.h>
+#include <private/test/compressor_instance.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLE_RATE         48000
+#define SAMPLE_RATE_HIGH    192000
+#define BUF_SIZE_MAX        0x1000
+
+namespace lsp
+{
+    namespace
+    {
+        typedef test::compressor_instance_t instance_t;
+
+        typedef struct variant_t
+        {
+            const meta::plugin_t   *meta;
+            bool                    sc;
+            size_t                  mode;
+        } variant_t;
+
+        static const variant_t variants[] =
+        {
+            { &meta::compressor_mono,       false, plugins::compressor::CM_MONO     },
+            { &meta::compressor_stereo,     false, plugins::compressor::CM_STEREO   },
+            { &meta::compressor_lr,         false, plugins::compressor::CM_LR       },
+            { &meta::compressor_ms,         false, plugins::compressor::CM_MS       },
+            { &meta::sc_compressor_mono,    true,  plugins::compressor::CM_MONO     },
+            { &meta::sc_compressor_stereo,  true,  plugins::compressor::CM_STEREO   },
+            { &meta::sc_compressor_lr,      true,  plugins::compressor::CM_LR       },
+            { &meta::sc_compressor_ms,      true,  plugins::compressor::CM_MS       },
+            { NULL, false, 0 }
+        };
+
+        enum bench_flags_t
+        {
+            B_PLAIN         = 1 << 0,   // Only for compressor without sidechain
+            B_SC            = 1 << 1,   // Only for compressor with sidechain
+            B_HIGH_RATE     = 1 << 2,   // Run at high sample rate
+            B_NO_UI         = 1 << 3,   // Run with deactivated UI
+            B_SILENCE       = 1 << 4    // Feed digital silence
+        };
+
+        typedef struct param_t
+        {
+            const char             *id;
+            float                   value;
+        } param_t;
+
+        /**
+         * Benchmark case: set of non-default port values applied after reset of all ports
+         */
+        typedef struct bench_t
+        {
+            const char             *label;
+            const size_t           *blocks;
+            size_t                  flags;
+            param_t                 params[4];
+        } bench_t;
+
+        static const size_t block_sizes[]   = { 32, 64, 128, 256, 512, 1024, 4096, 0 };
+        static const size_t chunk_blocks[]  = { 32, 128, 512, 1024, 4096, 0 };
+        static const size_t one_block[]     = { 256, 0 };
+
+        static const bench_t benches[] =
+        {
+            { "default",                block_sizes,    0,              { } },
+            { "bsize=auto",             chunk_blocks,   0,              { { "bsize", 0.0f } } },
+            { "bsize=low_latency",      chunk_blocks,   0,              { { "bsize", 1.0f } } },
+            { "bsize=balanced",         chunk_blocks,   0,              { { "bsize", 2.0f } } },
+            { "bsize=throughput",       chunk_blocks,   0,              { { "bsize", 3.0f } } },
+
+            { "sct=feed-forward",       one_block,      0,              { { "sct", 0.0f } } },
+            { "sct=feed-back",          one_block,      0,              { { "sct", 1.0f } } },
+            { "sct=external",           one_block,      B_SC,           { { "sct", 2.0f } } },
+            { "sct=link",               one_block,      B_PLAIN,        { { "sct", 2.0f } } },
+            { "sct=link",               one_block,      B_SC,           { { "sct", 3.0f } } },
+
+            { "sla=0.0 ms",             one_block,      0,              { { "sla", 0.0f } } },
+            { "sla=1.0 ms",             one_block,      0,              { { "sla", 1.0f } } },
+            { "sla=5.0 ms",             one_block,      0,              { { "sla", 5.0f } } },
+            { "sla=20.0 ms",            one_block,      0,              { { "sla", 20.0f } } },
+
+            { "premix=link",            one_block,      0,              { { "in2lk", GAIN_AMP_M_6_DB }, { "lk2in", GAIN_AMP_M_6_DB }, { "lk2sc", GAIN_AMP_M_6_DB } } },
+            { "premix=all",             one_block,      B_SC,           { { "in2lk", GAIN_AMP_M_6_DB }, { "in2sc", GAIN_AMP_M_6_DB }, { "sc2in", GAIN_AMP_M_6_DB } } },
+
+            { "gcm=exact",              one_block,      0,              { { "gcm", meta::compressor_metadata::GC_EXACT } } },
+            { "gcm=table",              one_block,      0,              { { "gcm", meta::compressor_metadata::GC_TABLE } } },
+            { "gcm=control, gcs=8",     one_block,      0,              { { "gcm", meta::compressor_metadata::GC_CONTROL }, { "gcs", 1.0f } } },
+            { "gcm=control, gcs=16",    one_block,      0,              { { "gcm", meta::compressor_metadata::GC_CONTROL }, { "gcs", 2.0f } } },
+            { "gcm=control, gcs=32",    one_block,      0,              { { "gcm", meta::compressor_metadata::GC_CONTROL }, { "gcs", 3.0f } } },
+            { "gcm=control, gcs=64",    one_block,      0,              { { "gcm", meta::compressor_metadata::GC_CONTROL }, { "gcs", 4.0f } } },
+
+            // The decimated detector is intended for high sample rates with band-limited sidechain
+            { "scdec=off, 192 kHz",     one_block,      B_HIGH_RATE,    { { "scr", 20.0f }, { "slpm", 2.0f }, { "slpf", 2000.0f } } },
+            { "scdec=on, 192 kHz",      one_block,      B_HIGH_RATE,    { { "scr", 20.0f }, { "slpm", 2.0f }, { "slpf", 2000.0f }, { "scdec", 1.0f } } },
+
+            { "graphs=off",             one_block,      B_NO_UI,        { } },
+            { "graphs=on",              one_block,      0,              { } },
+            { "silence",                one_block,      B_SILENCE,      { } },
+            { "bypass",                 one_block,      0,              { { "enabled", 0.0f } } },
+            { "bypass, sla=5.0 ms",     one_block,      0,              { { "enabled", 0.0f }, { "sla", 5.0f } } },
+
+            { NULL, NULL, 0, { } }
+        };
+    } /* namespace */
+} /* namespace lsp */
+
+PTEST_BEGIN("plugins", compressor, 1, 64)
+
+    void fill_signal(instance_t *inst, bool silence)
+    {
+        // Audio ports are filled with pseudo-random signal at about -12 dB or with digital silence
+        for (size_t i=0; i<inst->nports; ++i)
+        {
+            float *buf          = inst->buffers[i];
+            if (buf == NULL)
+                continue;
+            if (silence)
+                dsp::fill_zero(buf, BUF_SIZE_MAX);
+            else
+            {
+                for (size_t j=0; j<BUF_SIZE_MAX; ++j)
+                    buf[j]              = 0.25f * sinf(j * 0.031f) + 0.05f * (float(rand()) / RAND_MAX - 0.5f);
+            }
+        }
+    }
+
+    void setup(instance_t *inst, const bench_t *b)
+    {
+        plugins::compressor *p  = inst->plugin;
+
+        test::reset_ports(inst);
+        for (const param_t *param = b->params; param->id != NULL; ++param)
+            test::set_port(inst, param->id, param->value);
+
+        fill_signal(inst, b->flags & B_SILENCE);
+        p->set_sample_rate((b->flags & B_HIGH_RATE) ? SAMPLE_RATE_HIGH : SAMPLE_RATE);
+        if (b->flags & B_NO_UI)
+            p->ui_deactivated();
+        else
+            p->ui_activated();
+        p->update_settings();
+    }
+
+    void measure(instance_t *inst, const bench_t *b, size_t block)
+    {
+        plugins::compressor *p  = inst->plugin;
+        char key[128];
+
+        // Warm up caches and internal state for one second of audio
+        for (size_t i=0; i<(SAMPLE_RATE / block); ++i)
+            p->process(block);
+
+        snprintf(key, sizeof(key), "%s %s block=%d", inst->meta->uid, b->label, int(block));
+        printf("Testing %s...\n", key);
+        PTEST_KLOOP(key, block,
+            p->process(block);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        dsp::init();
+
+        for (const variant_t *v = variants; v->meta != NULL; ++v)
+        {
+            instance_t inst;
+            lsp_finally { test::destroy_instance(&inst); };
+
+            if (!test::create_instance(&inst, v->meta, v->sc, v->mode, SAMPLE_RATE, BUF_SIZE_MAX))
+            {
+                printf("Failed to create instance of %s\n", v->meta->uid);
+                continue;
+            }
+
+            for (const bench_t *b = benches; b->label != NULL; ++b)
+            {
+                if ((b->flags & B_PLAIN) && (v->sc))
+                    continue;
+                if ((b->flags & B_SC) && (!v->sc))
+                    continue;
+
+                setup(&inst, b);
+                for (const size_t *bs = b->blocks; *bs > 0; ++bs)
+                    measure(&inst, b, *bs);
+            }
+
+            PTEST_SEPARATOR;
+        }
+    }
+
+PTEST_END
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/dynamics/Compressor.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <private/plugins/compressor.h>
+#include <private/plugins/compressor_batch.h>
+#include <private/test/compressor_instance.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLE_RATE         48000
+#define BLOCK_SIZE          256
+#define LANES_MAX           128
+
+namespace lsp
+{
+    namespace
+    {
+        typedef test::compressor_instance_t instance_t;
+    } /* namespace */
+} /* namespace lsp */
+
+PTEST_BEGIN("plugins", compressor_batch, 5, 1000)
+
+    typedef struct context_t
+    {
+        dspu::Compressor        comp[LANES_MAX];
+        instance_t              inst[LANES_MAX];
+        float                  *in[LANES_MAX];
+        float                  *out[LANES_MAX];
+    } context_t;
+
+    bool setup_instance(instance_t *inst, size_t lane, const float *in)
+    {
+        if (!test::create_instance(inst, &meta::compressor_mono, false, plugins::compressor::CM_MONO, SAMPLE_RATE, BLOCK_SIZE))
+            return false;
+
+        // The closest configuration of the plugin to the lane of the batch: peak sidechain
+        // without lookahead, table gain computer, dry/wet mix and no graphs
+        test::set_port(inst, "scm", dspu::SCM_PEAK);
+        test::set_port(inst, "gcm", meta::compressor_metadata::GC_TABLE);
+        test::set_port(inst, "al", GAIN_AMP_M_12_DB);
+        test::set_port(inst, "rrl", GAIN_AMP_M_12_DB);
+        test::set_port(inst, "at", 5.0f + (lane % 8) * 2.0f);
+        test::set_port(inst, "rt", 50.0f + (lane % 4) * 25.0f);
+        test::set_port(inst, "cr", 4.0f);
+        test::set_port(inst, "kn", GAIN_AMP_M_6_DB);
+        test::set_port(inst, "cdr", 0.1f);
+        test::set_port(inst, "cwt", 0.9f);
+        dsp::copy(test::port_buffer(inst, "in"), in, BLOCK_SIZE);
+
+        inst->plugin->ui_deactivated();
+        inst->plugin->update_settings();
+
+        return true;
+    }
+
+    // Baseline: separate mono compressor plugin instance for each channel
+    void bench_instances(context_t *ctx, size_t lanes)
+    {
+        char key[128];
+        snprintf(key, sizeof(key), "instances lanes=%d", int(lanes));
+        printf("Testing %s...\n", key);
+
+        PTEST_KLOOP(key, BLOCK_SIZE * lanes,
+            for (size_t j=0; j<lanes; ++j)
+                ctx->inst[j].plugin->process(BLOCK_SIZE);
+        );
+    }
+
+    void bench_batch(context_t *ctx, size_t lanes, size_t width)
+    {
+        plugins::CompressorBatch batch;
+        lsp_finally { batch.destroy(); };
+        if (!batch.init(lanes, width))
+        {
+            printf("Failed to initialize batch of %d lanes\n", int(lanes));
+            return;
+        }
+        for (size_t j=0; j<lanes; ++j)
+        {
+            batch.update(j, &ctx->comp[j], SAMPLE_RATE);
+            batch.set_gains(j, 1.0f, 0.1f, 0.9f);
+        }
+        batch.clear();
+
+        char key[128];
+        snprintf(key, sizeof(key), "batch lanes=%d width=%d", int(lanes), int(width));
+        printf("Testing %s...\n", key);
+
+        PTEST_KLOOP(key, BLOCK_SIZE * lanes,
+            batch.process(ctx->out, ctx->in, NULL, BLOCK_SIZE);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        dsp::init();
+
+        context_t *ctx  = new context_t;
+        lsp_finally { delete ctx; };
+
+        float *data     = static_cast<float *>(malloc(sizeof(float) * BLOCK_SIZE * LANES_MAX * 2));
+        lsp_finally { free(data); };
+        if (data == NULL)
+            return;
+
+        for (size_t j=0; j<LANES_MAX; ++j)
+            memset(&ctx->inst[j], 0, sizeof(instance_t));
+        lsp_finally {
+            for (size_t j=0; j<LANES_MAX; ++j)
+            {
+                test::destroy_instance(&ctx->inst[j]);
+                ctx->comp[j].destroy();
+            }
+        };
+
+        srand(0);
+        for (size_t j=0; j<LANES_MAX; ++j)
+        {
+            dspu::Compressor *c = &ctx->comp[j];
+            c->construct();
+            c->set_sample_rate(SAMPLE_RATE);
+            c->set_threshold(GAIN_AMP_M_12_DB, GAIN_AMP_M_24_DB);
+            c->set_timings(5.0f + (j % 8) * 2.0f, 50.0f + (j % 4) * 25.0f);
+            c->set_ratio(4.0f);
+            c->set_knee(GAIN_AMP_M_6_DB);
+            c->update_settings();
+
+            ctx->in[j]      = &data[BLOCK_SIZE * j];
+            ctx->out[j]     = &data[BLOCK_SIZE * (LANES_MAX + j)];
+            for (size_t i=0; i<BLOCK_SIZE; ++i)
+                ctx->in[j][i]   = 2.0f * float(rand()) / float(RAND_MAX) - 1.0f;
+
+            if (!setup_instance(&ctx->inst[j], j, ctx->in[j]))
+            {
+                printf("Failed to create compressor instance for lane %d\n", int(j));
+                return;
+            }
+        }
+        for (size_t lanes=64; lanes <= LANES_MAX; lanes <<= 1)
+        {
+            bench_instances(ctx, lanes);
+            for (size_t width=4; width <= 16; width <<= 1)
+                bench_batch(ctx, lanes, width);
+
+            PTEST_SEPARATOR;
+        }
+    }
+
+PTEST_END
@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <private/plugins/compressor.h>
+#include <private/test/compressor_instance.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLE_RATE         48000
+#define CHECK_POINTS        48000
+#define CHUNK_SIZE          512
+
+namespace lsp
+{
+    namespace
+    {
+        typedef test::compressor_instance_t instance_t;
+    } /* namespace */
+} /* namespace lsp */
+
+UTEST_BEGIN("plugins", compressor)
+
+    void create_instance(instance_t *inst, const meta::plugin_t *metadata, size_t mode)
+    {
+        UTEST_ASSERT(test::create_instance(inst, metadata, false, mode, SAMPLE_RATE, CHUNK_SIZE));
+    }
+
+    void create_instance(instance_t *inst)
+    {
+        create_instance(inst, &meta::compressor_mono, plugins::compressor::CM_MONO);
+    }
+
+    void set_port(instance_t *inst, const char *id, float value)
+    {
+        if (test::set_port(inst, id, value) <= 0)
+            UTEST_FAIL_MSG("Port '%s' not found", id);
+    }
+
+    void setup_instance(instance_t *inst)
+    {
+        set_port(inst, "al", GAIN_AMP_M_24_DB);
+        set_port(inst, "at", 5.0f);
+        set_port(inst, "rt", 50.0f);
+        set_port(inst, "cr", 4.0f);
+        set_port(inst, "cdr", GAIN_AMP_M_INF_DB);
+        set_port(inst, "cwt", GAIN_AMP_0_DB);
+    }
+
+    void process(instance_t *inst, float *dst, const float *src, size_t count)
+    {
+        float *in       = test::port_buffer(inst, "in");
+        float *out      = test::port_buffer(inst, "out");
+        UTEST_ASSERT((in != NULL) && (out != NULL));
+
+        inst->plugin->update_settings();
+        for (size_t offset=0; offset < count; )
+        {
+            const size_t to_do  = lsp_min(count - offset, size_t(CHUNK_SIZE));
+            dsp::copy(in, &src[offset], to_do);
+            inst->plugin->process(to_do);
+            dsp::copy(&dst[offset], out, to_do);
+            offset             += to_do;
+        }
+    }
+
+    void process_stereo(instance_t *inst, float *dst_l, float *dst_r, const float *src_l, const float *src_r, size_t count)
+    {
+        float *in_l     = test::port_buffer(inst, "in_l");
+        float *in_r     = test::port_buffer(inst, "in_r");
+        float *out_l    = test::port_buffer(inst, "out_l");
+        float *out_r    = test::port_buffer(inst, "out_r");
+        UTEST_ASSERT((in_l != NULL) && (in_r != NULL) && (out_l != NULL) && (out_r != NULL));
+
+        inst->plugin->update_settings();
+        for (size_t offset=0; offset < count; )
+        {
+            const size_t to_do  = lsp_min(count - offset, size_t(CHUNK_SIZE));
+            dsp::copy(in_l, &src_l[offset], to_do);
+            dsp::copy(in_r, &src_r[offset], to_do);
+            inst->plugin->process(to_do);
+            dsp::copy(&dst_l[offset], out_l, to_do);
+            dsp::copy(&dst_r[offset], out_r, to_do);
+            offset             += to_do;
+        }
+    }
+
+    void gen_signal(float *dst, size_t count)
+    {
+        // Sine tone which alternates between -26 dB and -2 dB every 100 ms
+        const size_t period = SAMPLE_RATE / 10;
+        for (size_t i=0; i<count; ++i)
+        {
+            const float amp     = ((i / period) & 1) ? 0.8f : 0.05f;
+            dst[i]              = amp * sinf(2.0f * M_PI * 440.0f * i / SAMPLE_RATE);
+        }
+    }
+
+    void check_feedback_block(float *buf)
+    {
+        printf("Checking block feed-back mode against exact feed-back\n");
+
+        float *src      = buf;
+        float *exact    = &src[CHECK_POINTS];
+        float *block    = &exact[CHECK_POINTS];
+
+        gen_signal(src, CHECK_POINTS);
+
+        instance_t ie, ib;
+        create_instance(&ie);
+        lsp_finally { test::destroy_instance(&ie); };
+        create_instance(&ib);
+        lsp_finally { test::destroy_instance(&ib); };
+
+        setup_instance(&ie);
+        set_port(&ie, "sct", 1.0f); // Feed-back
+        set_port(&ie, "fbm", meta::compressor_metadata::FBM_EXACT);
+        setup_instance(&ib);
+        set_port(&ib, "sct", 1.0f); // Feed-back
+        set_port(&ib, "fbm", meta::compressor_metadata::FBM_BLOCK);
+
+        process(&ie, exact, src, CHECK_POINTS);
+        process(&ib, block, src, CHECK_POINTS);
+
+        // Restore gain curves from the output, the compressor introduces no latency here
+        for (size_t i=0; i<CHECK_POINTS; ++i)
+        {
+            const float s   = src[i];
+            if (fabsf(s) >= 1e-2f)
+            {
+                exact[i]        = exact[i] / s;
+                block[i]        = block[i] / s;
+            }
+            else
+            {
+                exact[i]        = (i > 0) ? exact[i-1] : 1.0f;
+                block[i]        = (i > 0) ? block[i-1] : 1.0f;
+            }
+        }
+
+        // The block mode delays the feed-back loop by FEEDBACK_BLOCK samples, so the deviation of
+        // the gain should stay within the change of the exact gain over the same number of samples
+        constexpr size_t delay  = meta::compressor_metadata::FEEDBACK_BLOCK;
+        float error     = 0.0f;
+        float change    = 0.0f;
+        for (size_t i=0; i<CHECK_POINTS; ++i)
+        {
+            error           = lsp_max(error, fabsf(block[i] - exact[i]));
+            if (i >= delay)
+                change          = lsp_max(change, fabsf(exact[i] - exact[i - delay]));
+        }
+
+        printf("  maximum gain deviation: %.6f (%.3f dB), maximum gain change over %d samples: %.6f\n",
+            error, 20.0f * log10f(1.0f + error), int(delay), change);
+        UTEST_ASSERT_MSG(error <= change * 2.0f + 1e-4f,
+            "Block feed-back deviation %.6f exceeds bound %.6f", error, change * 2.0f);
+    }
+
+    void check_idle_transition(float *buf)
+    {
+        printf("Checking idle to signal transition with and without the idle mode\n");
+
+        float *src      = buf;
+        float *idle     = &src[CHECK_POINTS];
+        float *full     = &idle[CHECK_POINTS];
+
+        // Signal, silence long enough to enter the idle mode, and signal again
+        constexpr size_t head   = CHECK_POINTS * 3 / 10;
+        constexpr size_t tail   = CHECK_POINTS / 5;
+        constexpr size_t pause  = CHECK_POINTS - head - tail;
+
+        gen_signal(src, head);
+        dsp::fill_zero(&src[head], pause);
+        gen_signal(&src[head + pause], tail);
+
+        instance_t ii, fi;
+        create_instance(&ii);
+        lsp_finally { test::destroy_instance(&ii); };
+        create_instance(&fi);
+        lsp_finally { test::destroy_instance(&fi); };
+
+        setup_instance(&ii);
+        set_port(&ii, "rt", 20.0f);
+        setup_instance(&fi);
+        set_port(&fi, "rt", 20.0f);
+
+        // Digital silence switches the compressor into the idle mode
+        process(&ii, idle, src, CHECK_POINTS);
+
+        // The signal at -600 dB keeps the whole chain processing while the detector decays
+        for (size_t i=0; i<pause; ++i)
+            src[head + i]   = (i & 1) ? 1e-30f : -1e-30f;
+        process(&fi, full, src, CHECK_POINTS);
+
+        float error     = 0.0f;
+        for (size_t i=0; i<CHECK_POINTS; ++i)
+            error           = lsp_max(error, fabsf(idle[i] - full[i]));
+
+        printf("  maximum deviation: %.9f\n", error);
+        UTEST_ASSERT_MSG(error <= 1e-6f,
+            "Output after the idle mode deviates by %.9f from the continuously processed output", error);
+    }
+
+    void check_lookahead_change(float *buf)
+    {
+        printf("Checking lookahead changes in the middle of the stream\n");
+
+        float *src      = buf;
+        float *a        = &src[CHECK_POINTS];
+        float *b        = &a[CHECK_POINTS];
+        float *c        = &b[CHECK_POINTS];
+        float *x        = &c[CHECK_POINTS];
+
+        gen_signal(src, CHECK_POINTS);
+
+        // Instances with constant lookahead give the signals before, between and after changes
+        static const float lookahead[] = { 2.0f, 10.0f, 5.0f };
+        float *ref[]    = { a, b, c };
+        for (size_t i=0; i<3; ++i)
+        {
+            instance_t inst;
+            create_instance(&inst);
+            lsp_finally { test::destroy_instance(&inst); };
+
+            setup_instance(&inst);
+            set_port(&inst, "sla", lookahead[i]);
+            process(&inst, ref[i], src, CHECK_POINTS);
+        }
+
+        // The second change arrives while the crossfade of the first one is running and is deferred
+        constexpr size_t first  = CHECK_POINTS / 4;
+        constexpr size_t second = first + 64;
+        instance_t xi;
+        create_instance(&xi);
+        lsp_finally { test::destroy_instance(&xi); };
+
+        setup_instance(&xi);
+        set_port(&xi, "sla", lookahead[0]);
+        process(&xi, x, src, first);
+        set_port(&xi, "sla", lookahead[1]);
+        process(&xi, &x[first], &src[first], second - first);
+        set_port(&xi, "sla", lookahead[2]);
+        process(&xi, &x[second], &src[second], CHECK_POINTS - second);
+
+        // The output is a crossfade between signals delayed by the old and the new lookahead,
+        // it should never leave the range of the reference signals
+        float before    = 0.0f;
+        float after     = 0.0f;
+        float outside   = 0.0f;
+        float change    = 0.0f;
+        for (size_t i=0; i<CHECK_POINTS; ++i)
+        {
+            const float lo  = lsp_min(lsp_min(a[i], b[i]), c[i]);
+            const float hi  = lsp_max(lsp_max(a[i], b[i]), c[i]);
+            if (i < first)
+                before          = lsp_max(before, fabsf(x[i] - a[i]));
+            else if (i >= CHECK_POINTS / 2)
+            {
+                after           = lsp_max(after, fabsf(x[i] - c[i]));
+                change          = lsp_max(change, fabsf(a[i] - c[i]));
+            }
+            else
+                outside         = lsp_max(outside, lsp_max(lo - x[i], x[i] - hi));
+        }
+
+        printf("  deviation before changes: %.9f, after changes: %.9f, outside of references: %.9f\n",
+            before, after, outside);
+        UTEST_ASSERT_MSG(change >= 1e-2f, "Lookahead change does not affect the output");
+        UTEST_ASSERT_MSG(before <= 1e-6f, "Output before the lookahead change deviates by %.9f", before);
+        UTEST_ASSERT_MSG(after <= 1e-6f, "Output after the lookahead change deviates by %.9f", after);
+        UTEST_ASSERT_MSG(outside <= 1e-6f, "Crossfade leaves the range of reference signals by %.9f", outside);
+    }
+
+    void check_stereo_link(float *buf)
+    {
+        printf("Checking linked stereo channels against Left/Right channels with the same settings\n");
+
+        float *src_l    = buf;
+        float *src_r    = &src_l[CHECK_POINTS];
+        float *st_l     = &src_r[CHECK_POINTS];
+        float *st_r     = &st_l[CHECK_POINTS];
+        float *lr_l     = &st_r[CHECK_POINTS];
+        float *lr_r     = &lr_l[CHECK_POINTS];
+
+        // Channels have different levels, so the gain of the wrong channel or buffer becomes visible
+        gen_signal(src_l, CHECK_POINTS);
+        for (size_t i=0; i<CHECK_POINTS; ++i)
+            src_r[i]        = 0.25f * src_l[(i * 3) % CHECK_POINTS];
+
+        // Stereo compressor without split computes the detector once and shares its buffers
+        instance_t si, li;
+        create_instance(&si, &meta::compressor_stereo, plugins::compressor::CM_STEREO);
+        lsp_finally { test::destroy_instance(&si); };
+        create_instance(&li, &meta::compressor_lr, plugins::compressor::CM_LR);
+        lsp_finally { test::destroy_instance(&li); };
+
+        setup_instance(&si);
+        set_port(&si, "ssplit", 0.0f);
+        set_port(&si, "scs", 5.0f); // Max
+        setup_instance(&li);
+        set_port(&li, "scs", 5.0f); // Max
+
+        process_stereo(&si, st_l, st_r, src_l, src_r, CHECK_POINTS);
+        process_stereo(&li, lr_l, lr_r, src_l, src_r, CHECK_POINTS);
+
+        float error     = 0.0f;
+        for (size_t i=0; i<CHECK_POINTS; ++i)
+            error           = lsp_max(error, lsp_max(fabsf(st_l[i] - lr_l[i]), fabsf(st_r[i] - lr_r[i])));
+
+        printf("  maximum deviation: %.9f\n", error);
+        UTEST_ASSERT_MSG(error <= 1e-6f,
+            "Output of linked stereo channels deviates by %.9f from independent channels", error);
+    }
+
+    UTEST_MAIN
+    {
+        float *buf = static_cast<float *>(malloc(sizeof(float) * CHECK_POINTS * 6));
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { free(buf); };
+
+        check_feedback_block(buf);
+        check_idle_transition(buf);
+        check_lookahead_change(buf);
+        check_stereo_link(buf);
+    }
+
+UTEST_END
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/dynamics/Compressor.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <private/plugins/compressor_batch.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+#define SAMPLE_RATE         48000
+#define CHECK_POINTS        0x4000
+#define CHECK_LANES         67
+
+UTEST_BEGIN("plugins", compressor_batch)
+
+    void check_batch(size_t width, float *buf)
+    {
+        printf("Checking batch of %d lanes, width=%d\n", int(CHECK_LANES), int(width));
+
+        dspu::Compressor comp[CHECK_LANES];
+        plugins::GainComputer gc[CHECK_LANES];
+        plugins::CompressorBatch batch;
+        const float *in[CHECK_LANES];
+        const float *sc[CHECK_LANES];
+        float *out[CHECK_LANES];
+
+        UTEST_ASSERT(batch.init(CHECK_LANES, width));
+
+        float *src      = buf;
+        float *gain     = &buf[CHECK_POINTS * CHECK_LANES];
+        float *env      = &buf[CHECK_POINTS * (CHECK_LANES + 1)];
+        float *dst      = &buf[CHECK_POINTS * (CHECK_LANES + 2)];
+
+        for (size_t j=0; j<CHECK_LANES; ++j)
+        {
+            comp[j].construct();
+            comp[j].set_sample_rate(SAMPLE_RATE);
+            comp[j].set_threshold(GAIN_AMP_M_12_DB * (1.0f - j * 0.01f), GAIN_AMP_M_36_DB);
+            comp[j].set_timings(1.0f + (j % 7) * 3.0f, 20.0f + (j % 5) * 40.0f);
+            comp[j].set_hold((j % 3) * 2.0f);
+            comp[j].set_ratio(2.0f + (j % 4) * 3.0f);
+            comp[j].set_knee(GAIN_AMP_M_6_DB);
+            comp[j].update_settings();
+
+            UTEST_ASSERT(gc[j].init());
+            gc[j].update(&comp[j], SAMPLE_RATE);
+            gc[j].clear();
+            batch.update(j, &comp[j], SAMPLE_RATE);
+            batch.set_gains(j, 1.0f + j * 0.01f, 0.1f, 0.9f);
+
+            // Bursts of noise with different periods for each lane, every third lane has own sidechain
+            in[j]       = &src[CHECK_POINTS * j];
+            sc[j]       = ((j % 3) == 0) ? &src[CHECK_POINTS * ((j + 1) % CHECK_LANES)] : NULL;
+            out[j]      = &dst[CHECK_POINTS * j];
+            for (size_t i=0; i<CHECK_POINTS; ++i)
+            {
+                const float level   = ((i / (0x400 + j * 37)) & 1) ? GAIN_AMP_0_DB : GAIN_AMP_M_48_DB;
+                src[CHECK_POINTS * j + i]   = level * (2.0f * float(rand()) / float(RAND_MAX) - 1.0f);
+            }
+        }
+        batch.clear();
+
+        lsp_finally {
+            for (size_t j=0; j<CHECK_LANES; ++j)
+            {
+                gc[j].destroy();
+                comp[j].destroy();
+            }
+            batch.destroy();
+        };
+
+        // Process the batch with blocks of random size
+        for (size_t offset=0; offset < CHECK_POINTS; )
+        {
+            const size_t block  = size_t(rand() % 300) + 1;
+            const size_t to_do  = lsp_min(CHECK_POINTS - offset, block);
+            const float *bin[CHECK_LANES], *bsc[CHECK_LANES];
+            float *bout[CHECK_LANES];
+            for (size_t j=0; j<CHECK_LANES; ++j)
+            {
+                bin[j]      = &in[j][offset];
+                bsc[j]      = (sc[j] != NULL) ? &sc[j][offset] : NULL;
+                bout[j]     = &out[j][offset];
+            }
+            batch.process(bout, bin, bsc, to_do);
+            offset             += to_do;
+        }
+
+        // The batch should give the same gain as separate gain computers, the dry/wet mix
+        // computed by DSP routines may differ in rounding only
+        for (size_t j=0; j<CHECK_LANES; ++j)
+        {
+            const float *s      = (sc[j] != NULL) ? sc[j] : in[j];
+            const float preamp  = 1.0f + j * 0.01f;
+            for (size_t i=0; i<CHECK_POINTS; ++i)
+                env[i]              = fabsf(s[i]) * preamp;
+            gc[j].process(gain, NULL, env, CHECK_POINTS);
+
+            for (size_t i=0; i<CHECK_POINTS; ++i)
+            {
+                const float v       = in[j][i] * (0.1f + 0.9f * gain[i]);
+                UTEST_ASSERT_MSG(fabsf(out[j][i] - v) <= fabsf(v) * 1e-6f,
+                    "Batch output differs at lane %d, sample %d: %f vs %f", int(j), int(i), out[j][i], v);
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        float *buf      = static_cast<float *>(malloc(sizeof(float) * CHECK_POINTS * (CHECK_LANES * 2 + 2)));
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { free(buf); };
+
+        srand(0);
+        for (size_t width=4; width <= 16; width <<= 1)
+            check_batch(width, buf);
+    }
+
+UTEST_END
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <private/plugins/compressor_delay.h>
+
+#include <stdlib.h>
+
+#define CHECK_POINTS        0x4000
+#define CHECK_LANES         3
+#define MAX_DELAY           1000
+#define MAX_BLOCK           128
+
+UTEST_BEGIN("plugins", compressor_delay)
+
+    void check_delay(float *buf)
+    {
+        printf("Checking multi-tap delay against plain delay, lanes=%d, max delay=%d, block=%d\n",
+            int(CHECK_LANES), int(MAX_DELAY), int(MAX_BLOCK));
+
+        plugins::MultiTapDelay dl;
+        UTEST_ASSERT(dl.init(CHECK_LANES, MAX_DELAY, MAX_BLOCK));
+        UTEST_ASSERT(dl.max_delay() == MAX_DELAY);
+        lsp_finally { dl.destroy(); };
+        dl.clear();
+
+        // Random signal for each lane, the delayed sample at position i is src[i - delay]
+        for (size_t i=0; i<CHECK_POINTS * CHECK_LANES; ++i)
+            buf[i]          = 2.0f * float(rand()) / float(RAND_MAX) - 1.0f;
+
+        // The ring buffer wraps many times, blocks of random size cross the wrap point at any offset
+        for (size_t offset=0; offset < CHECK_POINTS; )
+        {
+            const size_t to_do  = lsp_min(CHECK_POINTS - offset, size_t(rand() % MAX_BLOCK) + 1);
+            for (size_t j=0; j<CHECK_LANES; ++j)
+                dl.append(j, &buf[CHECK_POINTS * j + offset], to_do);
+
+            // Minimum, maximum and random delays of each lane
+            for (size_t j=0; j<CHECK_LANES; ++j)
+            {
+                const float *src    = &buf[CHECK_POINTS * j];
+                const size_t taps[] = { 0, MAX_DELAY, size_t(rand() % (MAX_DELAY + 1)), 1 + j };
+
+                for (size_t k=0; k<sizeof(taps)/sizeof(taps[0]); ++k)
+                {
+                    const size_t delay  = taps[k];
+                    const float *dst    = dl.tap(j, delay);
+                    for (size_t i=0; i<to_do; ++i)
+                    {
+                        const float v       = (offset + i >= delay) ? src[offset + i - delay] : 0.0f;
+                        UTEST_ASSERT_MSG(dst[i] == v,
+                            "Lane %d, delay %d differs at sample %d: %f vs %f",
+                            int(j), int(delay), int(offset + i), dst[i], v);
+                    }
+                }
+            }
+
+            dl.advance(to_do);
+            offset             += to_do;
+        }
+    }
+
+    UTEST_MAIN
+    {
+        float *buf      = static_cast<float *>(malloc(sizeof(float) * CHECK_POINTS * CHECK_LANES));
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { free(buf); };
+
+        srand(0);
+        check_delay(buf);
+    }
+
+UTEST_END
@@ -0,0 +1,332 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-compressor
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/dynamics/Compressor.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <private/plugins/compressor_gain.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+#define SAMPLE_RATE         48000
+#define CHECK_POINTS        0x10000
+#define MAX_ERROR_DB        0.05f
+
+namespace lsp
+{
+    namespace
+    {
+        typedef struct config_t
+        {
+            const char             *name;
+            dspu::compressor_mode_t mode;
+            float                   threshold;
+            float                   ratio;
+            float                   knee;
+            float                   boost;
+        } config_t;
+
+        static const config_t configs[] =
+        {
+            { "downward",           dspu::CM_DOWNWARD,  GAIN_AMP_M_12_DB,   4.0f,   GAIN_AMP_M_6_DB,    GAIN_AMP_M_72_DB    },
+            { "downward hard knee", dspu::CM_DOWNWARD,  GAIN_AMP_M_24_DB,   100.0f, GAIN_AMP_0_DB,      GAIN_AMP_M_72_DB    },
+            { "upward",             dspu::CM_UPWARD,    GAIN_AMP_M_24_DB,   2.0f,   GAIN_AMP_M_12_DB,   GAIN_AMP_M_48_DB    },
+            { "boosting",           dspu::CM_BOOSTING,  GAIN_AMP_M_36_DB,   8.0f,   GAIN_AMP_M_24_DB,   GAIN_AMP_P_12_DB    },
+            { NULL,                 dspu::CM_DOWNWARD,  0.0f,               0.0f,   0.0f,               0.0f                }
+        };
+
+        typedef struct timing_t
+        {
+            const char             *name;
+            float                   attack;     // Attack time [ms]
+            float                   release;    // Release time [ms]
+            float                   hold;       // Hold time [ms]
+            float                   threshold;  // Attack threshold
+            float                   rthresh;    // Release threshold
+        } timing_t;
+
+        static const timing_t timings[] =
+        {
+            { "fast",                       1.0f,   20.0f,  0.0f,   GAIN_AMP_M_12_DB,   GAIN_AMP_M_24_DB    },
+            { "slow",                       50.0f,  500.0f, 0.0f,   GAIN_AMP_M_24_DB,   GAIN_AMP_M_48_DB    },
+            { "hold",                       10.0f,  100.0f, 10.0f,  GAIN_AMP_M_24_DB,   GAIN_AMP_M_36_DB    },
+            { "high release threshold",     5.0f,   200.0f, 2.0f,   GAIN_AMP_M_36_DB,   GAIN_AMP_M_6_DB     },
+            { NULL,                         0.0f,   0.0f,   0.0f,   0.0f,               0.0f                }
+        };
+    } /* namespace */
+} /* namespace lsp */
+
+UTEST_BEGIN("plugins", compressor_gain)
+
+    void check_config(const config_t *cfg, float *x, float *exact)
+    {
+        printf("Checking gain table for '%s' compressor\n", cfg->name);
+
+        dspu::Compressor comp;
+        comp.construct();
+        comp.set_sample_rate(SAMPLE_RATE);
+        comp.set_mode(cfg->mode);
+        comp.set_threshold(cfg->threshold, cfg->threshold * GAIN_AMP_M_6_DB);
+        comp.set_boost_threshold(cfg->boost);
+        comp.set_timings(20.0f, 100.0f);
+        comp.set_ratio(cfg->ratio);
+        comp.set_knee(cfg->knee);
+        comp.update_settings();
+
+        plugins::GainComputer gc;
+        UTEST_ASSERT(gc.init());
+        gc.update(&comp, SAMPLE_RATE);
+
+        // Compare with the exact curve at random points between -120 dB and +48 dB
+        for (size_t i=0; i<CHECK_POINTS; ++i)
+            x[i]        = expf((float(rand()) / float(RAND_MAX) * 168.0f - 120.0f) * (M_LN10 / 20.0f));
+        comp.reduction(exact, x, CHECK_POINTS);
+
+        float error = 0.0f;
+        for (size_t i=0; i<CHECK_POINTS; ++i)
+            error       = lsp_max(error, fabsf(gc.reduction(x[i]) - exact[i]) / exact[i]);
+
+        const float reported    = gc.max_error();
+        printf("  reported error: %.6f dB, measured error: %.6f dB\n",
+            20.0f * log10f(1.0f + reported), 20.0f * log10f(1.0f + error));
+
+        UTEST_ASSERT_MSG(20.0f * log10f(1.0f + error) <= MAX_ERROR_DB,
+            "Error of the gain table %f dB exceeds %f dB", 20.0f * log10f(1.0f + error), MAX_ERROR_DB);
+        UTEST_ASSERT_MSG(error <= reported,
+            "Measured error %f exceeds the reported bound %f", error, reported);
+
+        gc.destroy();
+        comp.destroy();
+    }
+
+    void check_envelope(const timing_t *t, float *buf)
+    {
+        printf("Checking envelope follower against dspu::Compressor, '%s' timings\n", t->name);
+
+        dspu::Compressor comp;
+        comp.construct();
+        comp.set_sample_rate(SAMPLE_RATE);
+        comp.set_threshold(t->threshold, t->rthresh);
+        comp.set_timings(t->attack, t->release);
+        comp.set_hold(t->hold);
+        comp.set_ratio(4.0f);
+        comp.set_knee(GAIN_AMP_M_6_DB);
+        comp.update_settings();
+
+        plugins::GainComputer gc;
+        UTEST_ASSERT(gc.init());
+        gc.update(&comp, SAMPLE_RATE);
+        gc.clear();
+
+        float *in       = buf;
+        float *gain_a   = &buf[CHECK_POINTS];
+        float *env_a    = &buf[CHECK_POINTS*2];
+        float *gain_b   = &buf[CHECK_POINTS*3];
+        float *env_b    = &buf[CHECK_POINTS*4];
+
+        // Bursts of noise at different levels, the short bursts trigger the hold
+        for (size_t i=0; i<CHECK_POINTS; ++i)
+        {
+            const size_t burst  = i / 0x600;
+            const float level   = (burst & 1) ? GAIN_AMP_M_60_DB : ((burst & 2) ? GAIN_AMP_0_DB : GAIN_AMP_M_24_DB);
+            const float pulse   = ((i % 0x600) < 0x20) ? GAIN_AMP_P_12_DB : 1.0f;
+            in[i]               = level * pulse * float(rand()) / float(RAND_MAX);
+        }
+
+        for (size_t offset=0; offset < CHECK_POINTS; )
+        {
+            const size_t block  = size_t(rand() % 300) + 1;
+            const size_t to_do  = lsp_min(CHECK_POINTS - offset, block);
+            comp.process(&gain_a[offset], &env_a[offset], &in[offset], to_do);
+            gc.process(&gain_b[offset], &env_b[offset], &in[offset], to_do);
+            offset             += to_do;
+        }
+
+        // The envelope should follow the compressor, the gain should stay within the table error
+        float env_error     = 0.0f;
+        float gain_error    = 0.0f;
+        for (size_t i=0; i<CHECK_POINTS; ++i)
+        {
+            env_error           = lsp_max(env_error, fabsf(env_b[i] - env_a[i]) / lsp_max(env_a[i], GAIN_AMP_M_120_DB));
+            gain_error          = lsp_max(gain_error, fabsf(gain_b[i] - gain_a[i]) / gain_a[i]);
+        }
+
+        printf("  envelope error: %.6f, gain error: %.6f dB\n", env_error, 20.0f * log10f(1.0f + gain_error));
+        UTEST_ASSERT_MSG(env_error <= 1e-3f,
+            "Envelope deviates from the compressor by %f", env_error);
+        UTEST_ASSERT_MSG(20.0f * log10f(1.0f + gain_error) <= MAX_ERROR_DB * 2.0f,
+            "Gain deviates from the compressor by %f dB", 20.0f * log10f(1.0f + gain_error));
+
+        gc.destroy();
+        comp.destroy();
+    }
+
+    void check_control_rate(const timing_t *t, size_t step, float *buf)
+    {
+        dspu::Compressor comp;
+        comp.construct();
+        comp.set_sample_rate(SAMPLE_RATE);
+        comp.set_threshold(t->threshold, t->rthresh);
+        comp.set_timings(t->attack, t->release);
+        comp.set_hold(t->hold);
+        comp.set_ratio(4.0f);
+        comp.set_knee(GAIN_AMP_M_6_DB);
+        comp.update_settings();
+
+        plugins::GainComputer exact, ctl;
+        UTEST_ASSERT(exact.init());
+        UTEST_ASSERT(ctl.init());
+        exact.update(&comp, SAMPLE_RATE);
+        ctl.update(&comp, SAMPLE_RATE);
+        ctl.set_step(step);
+        exact.clear();
+        ctl.clear();
+
+        printf("Checking control rate gain computer, '%s' timings, step=%d\n", t->name, int(ctl.step()));
+
+        // Feed the level steps between -36 dB and 0 dB with blocks of random size
+        float *in       = buf;
+        float *gain     = &buf[CHECK_POINTS];
+        float *env_a    = &buf[CHECK_POINTS*2];
+        float *env_b    = &buf[CHECK_POINTS*3];
+        for (size_t i=0; i<CHECK_POINTS; ++i)
+            in[i]       = ((i / 0x2000) & 1) ? GAIN_AMP_0_DB : GAIN_AMP_M_36_DB;
+
+        for (size_t offset=0; offset < CHECK_POINTS; )
+        {
+            const size_t block  = size_t(rand() % 300) + 1;
+            const size_t to_do  = lsp_min(CHECK_POINTS - offset, block);
+            exact.process(gain, &env_a[offset], &in[offset], to_do);
+            ctl.process_control(gain, &env_b[offset], &in[offset], to_do);
+            offset             += to_do;
+        }
+
+        float error = 0.0f;
+        for (size_t i=0; i<CHECK_POINTS; ++i)
+            error       = lsp_max(error, fabsf(env_b[i] - env_a[i]) / (GAIN_AMP_0_DB - GAIN_AMP_M_36_DB));
+
+        const float reported    = ctl.control_error();
+        printf("  reported error: %.6f, measured error: %.6f\n", reported, error);
+        UTEST_ASSERT_MSG(error <= reported + 1e-5f,
+            "Measured error %f exceeds reported error %f", error, reported);
+
+        ctl.destroy();
+        exact.destroy();
+        comp.destroy();
+    }
+
+    void check_lockstep(float *buf)
+    {
+        printf("Checking lockstep processing of two gain computers\n");
+
+        dspu::Compressor comp[2];
+        plugins::GainComputer single[2], pair[2];
+        float *in[2], *gain[2], *env[2], *pgain[2], *penv[2];
+
+        for (size_t j=0; j<2; ++j)
+        {
+            comp[j].construct();
+            comp[j].set_sample_rate(SAMPLE_RATE);
+            comp[j].set_threshold((j == 0) ? GAIN_AMP_M_12_DB : GAIN_AMP_M_24_DB, GAIN_AMP_M_36_DB);
+            comp[j].set_timings((j == 0) ? 5.0f : 20.0f, (j == 0) ? 50.0f : 200.0f);
+            comp[j].set_hold((j == 0) ? 0.0f : 5.0f);
+            comp[j].set_ratio((j == 0) ? 4.0f : 10.0f);
+            comp[j].set_knee(GAIN_AMP_M_6_DB);
+            comp[j].update_settings();
+
+            UTEST_ASSERT(single[j].init());
+            UTEST_ASSERT(pair[j].init());
+            single[j].update(&comp[j], SAMPLE_RATE);
+            pair[j].update(&comp[j], SAMPLE_RATE);
+            single[j].clear();
+            pair[j].clear();
+
+            // Bursts of noise with different periods for each lane
+            in[j]       = &buf[CHECK_POINTS * j];
+            gain[j]     = &buf[CHECK_POINTS * (2 + j)];
+            env[j]      = &buf[CHECK_POINTS * (4 + j)];
+            pgain[j]    = &buf[CHECK_POINTS * (6 + j)];
+            penv[j]     = &buf[CHECK_POINTS * (8 + j)];
+            for (size_t i=0; i<CHECK_POINTS; ++i)
+            {
+                const float level   = ((i / (0x800 << j)) & 1) ? GAIN_AMP_0_DB : GAIN_AMP_M_48_DB;
+                in[j][i]            = level * float(rand()) / float(RAND_MAX);
+            }
+        }
+
+        plugins::GainComputer * const gc[2] = { &pair[0], &pair[1] };
+        for (size_t offset=0; offset < CHECK_POINTS; )
+        {
+            const size_t block  = size_t(rand() % 300) + 1;
+            const size_t to_do  = lsp_min(CHECK_POINTS - offset, block);
+            float * const dg[2] = { &pgain[0][offset], &pgain[1][offset] };
+            float * const de[2] = { &penv[0][offset], &penv[1][offset] };
+            const float *src[2] = { &in[0][offset], &in[1][offset] };
+
+            for (size_t j=0; j<2; ++j)
+                single[j].process(&gain[j][offset], &env[j][offset], &in[j][offset], to_do);
+            plugins::GainComputer::process_x2(gc, dg, de, src, to_do);
+            offset             += to_do;
+        }
+
+        // The lockstep processing should give exactly the same result
+        for (size_t j=0; j<2; ++j)
+            for (size_t i=0; i<CHECK_POINTS; ++i)
+            {
+                UTEST_ASSERT_MSG((pgain[j][i] == gain[j][i]) && (penv[j][i] == env[j][i]),
+                    "Lockstep output differs at lane %d, sample %d", int(j), int(i));
+            }
+
+        for (size_t j=0; j<2; ++j)
+        {
+            pair[j].destroy();
+            single[j].destroy();
+            comp[j].destroy();
+        }
+    }
+
+    UTEST_MAIN
+    {
+        float *x        = static_cast<float *>(malloc(sizeof(float) * CHECK_POINTS * 10));
+        UTEST_ASSERT(x != NULL);
+        lsp_finally { free(x); };
+
+        srand(0);
+        for (const config_t *cfg = configs; cfg->name != NULL; ++cfg)
+            check_config(cfg, x, &x[CHECK_POINTS]);
+        for (const timing_t *t = timings; t->name != NULL; ++t)
+            check_envelope(t, x);
+
+        for (const timing_t *t = timings; t->name != NULL; ++t)
+        {
+            check_control_rate(t, 0, x);
+            for (size_t step=8; step <= 64; step <<= 1)
+                check_control_rate(t, step, x);
+        }
+
+        check_lockstep(x);
+    }
+
+UTEST_END